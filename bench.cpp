@@ -0,0 +1,1511 @@
+/*! \file
+* \brief Benchmarks of lists, prints results as csv
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <list>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "fast_list.h"
+#include "ptr_list.h"
+#include "sharded_list.h"
+#include "unrolled_list.h"
+#include "xor_list.h"
+#include "list_wrappers.h"
+#include "bench_tools.h"
+#include "logs.h"
+
+static const size_t DEFAULT_BENCH_ELEMS = 1000000;
+static const int    BENCH_REPEATS       = 5;
+
+static const size_t LISTS_BENCH_ELEMS[] = {1000, 1000000, 100000000};
+static const size_t MAX_RANDOM_OPS      = 1000000;
+/// footprint of small list is averaged over many lists, one list is smaller than malloc noise
+static const size_t FOOTPRINT_LISTS     = 1000;
+static const size_t FOOTPRINT_ELEMS[]   = {4, 16, 64};
+/// elements of wrappers suite are split between lists, which are moved into vector
+static const size_t WRAPPED_LISTS       = 16;
+/// paranoid checks walk the whole list on every change
+static const size_t MAX_PARANOID_ELEMS  = 10000;
+/// random operations use positions from a sample of live elements, it bounds memory of benchmark
+static const size_t MAX_BENCH_HANDLES   = 1 << 20;
+
+static const size_t CONCURRENT_BENCH_THREADS[] = {1, 2, 4, 8, 16, 32, 64};
+static const size_t CONCURRENT_BENCH_BATCH     = 16;
+
+static const size_t AGGREGATE_BENCH_THREADS    = 4;
+static const size_t HISTOGRAM_BENCH_BUCKETS    = 64;
+static const size_t REMOVE_VALUE_BENCH_OPS     = 1000;
+static const size_t PAGE_BENCH_OPS             = 1000;
+static const size_t PAGE_BENCH_ELEMS           = 50;
+static const size_t UNROLLED_BENCH_INSERTS     = 100;
+static const size_t STARTUP_BENCH_CAPACITY     = 100000000;
+
+static const double LATENCY_PERCENTILES[]      = {50, 99, 99.9, 100};
+static const char*  LATENCY_PERCENTILE_NAMES[] = {"p50_ns", "p99_ns", "p99.9_ns", "max_ns"};
+
+/// payload of given size in bytes
+template <size_t N>
+struct Payload
+{
+    unsigned char bytes[N];
+};
+
+enum class BuildOrder
+{
+    SEQUENTIAL,     ///< appends only, physical order equals logical order
+    SHUFFLED,       ///< inserts after random elements, links jump over the array
+};
+
+static volatile size_t BENCH_SINK = 0;
+
+static ErrorInfo BENCH_ERROR = {};
+
+typedef std::list<int> stdlist_t;
+
+typedef FastList<int, ListLayout::CHUNKED> chunked_list_t;
+
+/// position of element, which stays valid until element is removed
+template <class ListT>
+struct BenchHandle;
+
+template <>
+struct BenchHandle<list_t>      { typedef size_t type; };
+template <>
+struct BenchHandle<ptrlist_t>   { typedef PtrListElem* type; };
+template <>
+struct BenchHandle<stdlist_t>   { typedef stdlist_t::iterator type; };
+
+static int  CompareFloats(const void* first, const void* second);
+
+template <class ListT>
+static void RunLayoutBench(FILE* out, const char* layout, const size_t elems, const BuildOrder order);
+
+template <size_t N>
+static void RunPayloadBench(FILE* out, const size_t elems);
+
+template <class ListT>
+static void RunGrowthBench(FILE* out, const char* layout, const size_t elems);
+
+template <class ListT>
+static void RunChecksBench(FILE* out, const char* checks, const size_t elems);
+
+static void RunLogsBench(FILE* out, const size_t records);
+
+template <class ListT>
+static void RunSearchBench(FILE* out, const char* layout, const size_t elems);
+
+static void RunUnrolledBench(FILE* out, const size_t elems);
+static void RunStartupBench(FILE* out, const size_t capacity, const bool eager_fill);
+template <class ListT>
+static void RunWidthBench(FILE* out, const char* width, const size_t elems);
+template <class ListT>
+static void RunFootprintBench(FILE* out, const char* width, const size_t elems);
+static void RunXorBench(FILE* out, const size_t elems);
+static void RunWrappersBench(FILE* out, const size_t elems);
+static ListWrapper<> MakeWrappedList(const size_t elems);
+
+template <class ListT>
+static void RunListsBenchIsolated(FILE* out, const char* name, const size_t elems);
+template <class ListT>
+static void RunListsBench(FILE* out, const char* name, const size_t elems);
+static void PrintListsResult(FILE* out, const char* name, const size_t elems, const char* order,
+                             const char* operation, const size_t ops, const double time,
+                             CacheCounter* counter);
+
+static void RunConcurrentBench(FILE* out, const size_t threads_amt, const size_t ops);
+static void ReserveSlotsWorker(chunked_list_t* list, ListConcurrentSlots* slots, const size_t batches);
+static void LockedInsertsWorker(chunked_list_t* list, std::mutex* lock, const size_t batches);
+static void ShardAppendsWorker(ShardedList<list_t>* sharded, const size_t shard, const size_t appends);
+
+//-----------------------------------------------------------------------------------------------------
+
+int main(const int argc, const char* argv[])
+{
+    const char* suite = (argc > 1) ? argv[1] : "all";
+    size_t      elems = (argc > 2) ? strtoul(argv[2], nullptr, 10) : DEFAULT_BENCH_ELEMS;
+
+    bool run_all = (strcmp(suite, "all") == 0);
+
+    PrintCsvHeader(stdout);
+
+    if (run_all || strcmp(suite, "layout") == 0)
+    {
+        RunPayloadBench<4>(stdout, elems);
+        RunPayloadBench<16>(stdout, elems);
+        RunPayloadBench<64>(stdout, elems);
+    }
+
+    if (run_all || strcmp(suite, "growth") == 0)
+    {
+        RunGrowthBench<FastList<int, ListLayout::AOS>>(stdout, "aos", elems);
+        RunGrowthBench<FastList<int, ListLayout::SOA>>(stdout, "soa", elems);
+        RunGrowthBench<FastList<int, ListLayout::CHUNKED>>(stdout, "chunked", elems);
+    }
+
+    if (run_all || strcmp(suite, "checks") == 0)
+    {
+        size_t paranoid_elems = (elems < MAX_PARANOID_ELEMS) ? elems : MAX_PARANOID_ELEMS;
+
+        RunChecksBench<FastList<int, ListLayout::AOS, ListChecks::UNCHECKED>>(stdout, "unchecked", elems);
+        RunChecksBench<FastList<int, ListLayout::AOS, ListChecks::LIGHT>>(stdout, "light", elems);
+        RunChecksBench<FastList<int, ListLayout::AOS, ListChecks::PARANOID>>(stdout, "paranoid", paranoid_elems);
+    }
+
+    if (run_all || strcmp(suite, "logs") == 0)
+        RunLogsBench(stdout, (elems < MAX_RANDOM_OPS) ? elems : MAX_RANDOM_OPS);
+
+    if (run_all || strcmp(suite, "lists") == 0)
+    {
+        const size_t* sizes      = (argc > 2) ? &elems : LISTS_BENCH_ELEMS;
+        size_t        sizes_amt  = (argc > 2) ? 1 : sizeof(LISTS_BENCH_ELEMS) / sizeof(LISTS_BENCH_ELEMS[0]);
+
+        for (size_t i = 0; i < sizes_amt; i++)
+        {
+            RunListsBenchIsolated<list_t>(stdout, "fast_list", sizes[i]);
+            RunListsBenchIsolated<ptrlist_t>(stdout, "ptr_list", sizes[i]);
+            RunListsBenchIsolated<stdlist_t>(stdout, "std_list", sizes[i]);
+        }
+    }
+
+    if (run_all || strcmp(suite, "search") == 0)
+    {
+        RunSearchBench<FastList<int, ListLayout::AOS>>(stdout, "aos", elems);
+        RunSearchBench<FastList<int, ListLayout::SOA>>(stdout, "soa", elems);
+        RunSearchBench<FastList<int, ListLayout::CHUNKED>>(stdout, "chunked", elems);
+    }
+
+    if (run_all || strcmp(suite, "unrolled") == 0)
+        RunUnrolledBench(stdout, elems);
+
+    if (run_all || strcmp(suite, "startup") == 0)
+    {
+        size_t capacity = (argc > 2) ? elems : STARTUP_BENCH_CAPACITY;
+
+        RunStartupBench(stdout, capacity, false);
+        RunStartupBench(stdout, capacity, true);
+    }
+
+    if (run_all || strcmp(suite, "width") == 0)
+    {
+        typedef FastList<int, ListLayout::AOS, DEFAULT_LIST_CHECKS, int16_t> short_list_t;
+
+        // 16-bit links address only 32K slots, slot 0 is fictive
+        size_t short_elems = (elems < GetMaxListCapacity<short_list_t>()) ? elems : GetMaxListCapacity<short_list_t>() - 1;
+
+        RunWidthBench<short_list_t>(stdout, "int16", short_elems);
+        RunWidthBench<FastList<int, ListLayout::AOS, DEFAULT_LIST_CHECKS, int32_t>>(stdout, "int32", short_elems);
+        RunWidthBench<FastList<int, ListLayout::AOS, DEFAULT_LIST_CHECKS, int32_t>>(stdout, "int32", elems);
+        RunWidthBench<FastList<int, ListLayout::AOS, DEFAULT_LIST_CHECKS, int64_t>>(stdout, "int64", elems);
+
+        for (size_t small_elems : FOOTPRINT_ELEMS)
+        {
+            RunFootprintBench<short_list_t>(stdout, "int16", small_elems);
+            RunFootprintBench<FastList<int, ListLayout::AOS, DEFAULT_LIST_CHECKS, int32_t>>(stdout, "int32", small_elems);
+            RunFootprintBench<FastList<int, ListLayout::AOS, DEFAULT_LIST_CHECKS, int64_t>>(stdout, "int64", small_elems);
+        }
+    }
+
+    if (run_all || strcmp(suite, "xor") == 0)
+        RunXorBench(stdout, elems);
+
+    if (run_all || strcmp(suite, "wrappers") == 0)
+        RunWrappersBench(stdout, elems);
+
+    if (run_all || strcmp(suite, "concurrent") == 0)
+    {
+        for (size_t i = 0; i < sizeof(CONCURRENT_BENCH_THREADS) / sizeof(CONCURRENT_BENCH_THREADS[0]); i++)
+            RunConcurrentBench(stdout, CONCURRENT_BENCH_THREADS[i], (elems < MAX_RANDOM_OPS) ? elems : MAX_RANDOM_OPS);
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <size_t N>
+static void RunPayloadBench(FILE* out, const size_t elems)
+{
+    typedef FastList<Payload<N>, ListLayout::AOS> aos_list_t;
+    typedef FastList<Payload<N>, ListLayout::SOA> soa_list_t;
+
+    RunLayoutBench<aos_list_t>(out, "aos", elems, BuildOrder::SEQUENTIAL);
+    RunLayoutBench<soa_list_t>(out, "soa", elems, BuildOrder::SEQUENTIAL);
+    RunLayoutBench<aos_list_t>(out, "aos", elems, BuildOrder::SHUFFLED);
+    RunLayoutBench<soa_list_t>(out, "soa", elems, BuildOrder::SHUFFLED);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void RunLayoutBench(FILE* out, const char* layout, const size_t elems, const BuildOrder order)
+{
+    typedef typename ListT::data_t T;
+
+    const char* order_name = (order == BuildOrder::SEQUENTIAL) ? "sequential" : "shuffled";
+
+    ListT     list   = {};
+    ErrorInfo error  = {};
+    size_t    state  = 88172645463325252ull;
+
+    ListCtor(&list, &error);
+
+    T value = {};
+
+    double start = GetTimeNs();
+
+    size_t pos = 0;
+    for (size_t i = 0; i < elems; i++)
+    {
+        value.bytes[0] = (unsigned char) i;
+
+        // there are no removals, so slots 1..size are all busy
+        size_t after = (order == BuildOrder::SEQUENTIAL) ? pos : XorShift(&state) % (list.size + 1);
+
+        ListInsertAfterElem(&list, after, value, &pos, &error);
+    }
+
+    PrintCsvLine(out, "layout", layout, sizeof(T), elems, order_name, "build", "ns_per_op",
+                 (GetTimeNs() - start) / (double) elems);
+
+    // ----- link walk, touches only next -----
+
+    start = GetTimeNs();
+
+    size_t count = 0;
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+    {
+        for (size_t cur = GetListHead(&list); cur != FICTIVE_ELEM_POS; cur = ListNext(&list, cur))
+            count++;
+    }
+    BENCH_SINK = count;
+
+    PrintCsvLine(out, "layout", layout, sizeof(T), elems, order_name, "link_walk", "ns_per_op",
+                 (GetTimeNs() - start) / (double) (elems * BENCH_REPEATS));
+
+    // ----- value scan over physical array, touches only data -----
+
+    start = GetTimeNs();
+
+    size_t sum = 0;
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+    {
+        for (size_t cur = 1; cur <= list.size; cur++)
+            sum += ListData(&list, cur).bytes[0];
+    }
+    BENCH_SINK = sum;
+
+    PrintCsvLine(out, "layout", layout, sizeof(T), elems, order_name, "value_scan", "ns_per_op",
+                 (GetTimeNs() - start) / (double) (elems * BENCH_REPEATS));
+
+    // ----- logical traversal, touches next and data -----
+
+    start = GetTimeNs();
+
+    sum = 0;
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+    {
+        for (size_t cur = GetListHead(&list); cur != FICTIVE_ELEM_POS; cur = ListNext(&list, cur))
+            sum += ListData(&list, cur).bytes[0];
+    }
+    BENCH_SINK = sum;
+
+    PrintCsvLine(out, "layout", layout, sizeof(T), elems, order_name, "traverse", "ns_per_op",
+                 (GetTimeNs() - start) / (double) (elems * BENCH_REPEATS));
+
+    ListDtor(&list);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void RunGrowthBench(FILE* out, const char* layout, const size_t elems)
+{
+    ListT     list  = {};
+    ErrorInfo error = {};
+
+    ListCtor(&list, &error);
+
+    float* latencies = (float*) calloc(elems, sizeof(float));
+    assert(latencies);
+
+    size_t pos   = 0;
+    double total = GetTimeNs();
+
+    for (size_t i = 0; i < elems; i++)
+    {
+        double start = GetTimeNs();
+
+        ListInsertAfterElem(&list, pos, (int) i, &pos, &error);
+
+        latencies[i] = (float) (GetTimeNs() - start);
+    }
+
+    total = GetTimeNs() - total;
+
+    qsort(latencies, elems, sizeof(float), CompareFloats);
+
+    PrintCsvLine(out, "growth", layout, sizeof(int), elems, "sequential", "push_back", "ns_per_op",
+                 total / (double) elems);
+
+    for (size_t i = 0; i < sizeof(LATENCY_PERCENTILES) / sizeof(LATENCY_PERCENTILES[0]); i++)
+    {
+        size_t index = (size_t) ((double) (elems - 1) * LATENCY_PERCENTILES[i] / 100);
+
+        PrintCsvLine(out, "growth", layout, sizeof(int), elems, "sequential", "push_back",
+                     LATENCY_PERCENTILE_NAMES[i], latencies[index]);
+    }
+
+    free(latencies);
+    ListDtor(&list);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void RunChecksBench(FILE* out, const char* checks, const size_t elems)
+{
+    ListT     list  = {};
+    ErrorInfo error = {};
+    size_t    state = 88172645463325252ull;
+
+    ListCtor(&list, &error);
+
+    // ----- appends -----
+
+    double start = GetTimeNs();
+
+    size_t pos = 0;
+    for (size_t i = 0; i < elems; i++)
+        ListInsertBeforeElem(&list, FICTIVE_ELEM_POS, (int) i, &pos, &error);
+
+    PrintCsvLine(out, "checks", checks, sizeof(int), elems, "sequential", "insert", "ns_per_op",
+                 (GetTimeNs() - start) / (double) elems);
+
+    // ----- reads of random elements, slots 1..elems are all busy -----
+
+    start = GetTimeNs();
+
+    size_t sum = 0;
+    for (size_t i = 0; i < elems; i++)
+    {
+        int value = 0;
+        GetListElement(&list, 1 + XorShift(&state) % elems, &value, &error);
+
+        sum += (size_t) value;
+    }
+    BENCH_SINK = sum;
+
+    PrintCsvLine(out, "checks", checks, sizeof(int), elems, "random", "get", "ns_per_op",
+                 (GetTimeNs() - start) / (double) elems);
+
+    // ----- removes in random order -----
+
+    size_t* order = (size_t*) calloc(elems, sizeof(size_t));
+    assert(order);
+
+    for (size_t i = 0; i < elems; i++)
+        order[i] = i + 1;
+
+    for (size_t i = elems; i > 1; i--)
+        std::swap(order[i - 1], order[XorShift(&state) % i]);
+
+    start = GetTimeNs();
+
+    for (size_t i = 0; i < elems; i++)
+        ListRemoveElem(&list, order[i], &error);
+
+    PrintCsvLine(out, "checks", checks, sizeof(int), elems, "random", "remove", "ns_per_op",
+                 (GetTimeNs() - start) / (double) elems);
+
+    free(order);
+    ListDtor(&list);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void RunSearchBench(FILE* out, const char* layout, const size_t elems)
+{
+    ListT     list  = {};
+    ErrorInfo error = {};
+    size_t    state = 88172645463325252ull;
+
+    ListCtor(&list, &error);
+
+    size_t pos = 0;
+    for (size_t i = 0; i < elems; i++)
+        ListInsertAfterElem(&list, XorShift(&state) % (list.size + 1), (int) i, &pos, &error);
+
+    // searched value is not in list, so every search goes over all elements
+    const int missing = -1;
+
+    // ----- find by link walk -----
+
+    double start = GetTimeNs();
+
+    size_t found = 0;
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+    {
+        size_t cur = GetListHead(&list);
+        while (cur != FICTIVE_ELEM_POS && ListData(&list, cur) != missing)
+            cur = ListNext(&list, cur);
+
+        found += cur;
+    }
+    BENCH_SINK = found;
+
+    PrintCsvLine(out, "search", layout, sizeof(int), elems, "shuffled", "find_walk", "ns_per_elem",
+                 (GetTimeNs() - start) / (double) (elems * BENCH_REPEATS));
+
+    // ----- find and count by physical scan -----
+
+    start = GetTimeNs();
+
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+        found += ListFindValue(&list, missing);
+    BENCH_SINK = found;
+
+    PrintCsvLine(out, "search", layout, sizeof(int), elems, "shuffled", "find_scan", "ns_per_elem",
+                 (GetTimeNs() - start) / (double) (elems * BENCH_REPEATS));
+
+    start = GetTimeNs();
+
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+        found += ListCountValue(&list, missing);
+    BENCH_SINK = found;
+
+    PrintCsvLine(out, "search", layout, sizeof(int), elems, "shuffled", "count_scan", "ns_per_elem",
+                 (GetTimeNs() - start) / (double) (elems * BENCH_REPEATS));
+
+    // ----- aggregates by link walk and by physical scan -----
+
+    start = GetTimeNs();
+
+    long long sum = 0;
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+    {
+        for (size_t cur = GetListHead(&list); cur != FICTIVE_ELEM_POS; cur = ListNext(&list, cur))
+            sum += ListData(&list, cur);
+    }
+    BENCH_SINK = (size_t) sum;
+
+    PrintCsvLine(out, "search", layout, sizeof(int), elems, "shuffled", "sum_walk", "ns_per_elem",
+                 (GetTimeNs() - start) / (double) (elems * BENCH_REPEATS));
+
+    IntAggregates aggregates = {};
+    size_t        counts[HISTOGRAM_BENCH_BUCKETS] = {};
+    IntHistogram  histogram  = {0, (int) (elems / HISTOGRAM_BENCH_BUCKETS) + 1, HISTOGRAM_BENCH_BUCKETS, counts};
+
+    const size_t threads[] = {1, AGGREGATE_BENCH_THREADS};
+
+    for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); i++)
+    {
+        char operation[32] = "";
+
+        start = GetTimeNs();
+
+        for (int rep = 0; rep < BENCH_REPEATS; rep++)
+            ListAggregate(&list, &aggregates, &error, threads[i]);
+        BENCH_SINK = (size_t) aggregates.sum;
+
+        snprintf(operation, sizeof(operation), "aggregate_%zu_threads", threads[i]);
+        PrintCsvLine(out, "search", layout, sizeof(int), elems, "shuffled", operation, "ns_per_elem",
+                     (GetTimeNs() - start) / (double) (elems * BENCH_REPEATS));
+
+        start = GetTimeNs();
+
+        for (int rep = 0; rep < BENCH_REPEATS; rep++)
+            ListCountHistogram(&list, &histogram, &error, threads[i]);
+        BENCH_SINK = counts[0];
+
+        snprintf(operation, sizeof(operation), "histogram_%zu_threads", threads[i]);
+        PrintCsvLine(out, "search", layout, sizeof(int), elems, "shuffled", operation, "ns_per_elem",
+                     (GetTimeNs() - start) / (double) (elems * BENCH_REPEATS));
+    }
+
+    // ----- in-place update by link walk and by parallel transform -----
+
+    start = GetTimeNs();
+
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+    {
+        for (size_t cur = GetListHead(&list); cur != FICTIVE_ELEM_POS; cur = ListNext(&list, cur))
+            ListData(&list, cur) ^= rep;
+    }
+
+    PrintCsvLine(out, "search", layout, sizeof(int), elems, "shuffled", "transform_walk", "ns_per_elem",
+                 (GetTimeNs() - start) / (double) (elems * BENCH_REPEATS));
+
+    for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); i++)
+    {
+        char operation[32] = "";
+
+        start = GetTimeNs();
+
+        for (int rep = 0; rep < BENCH_REPEATS; rep++)
+            ListParallelTransform(&list, [rep](int& value, const size_t /* pos */) { value ^= rep; }, &error, threads[i]);
+
+        snprintf(operation, sizeof(operation), "transform_%zu_threads", threads[i]);
+        PrintCsvLine(out, "search", layout, sizeof(int), elems, "shuffled", operation, "ns_per_elem",
+                     (GetTimeNs() - start) / (double) (elems * BENCH_REPEATS));
+    }
+
+    ListDtor(&list);
+
+    // ----- find and remove by scan and by value index -----
+
+    size_t removes = (elems < REMOVE_VALUE_BENCH_OPS) ? elems : REMOVE_VALUE_BENCH_OPS;
+    size_t step    = (removes > 0) ? elems / removes : 1;
+
+    for (int indexed = 0; indexed <= 1; indexed++)
+    {
+        ListCtor(&list, &error);
+
+        state = 88172645463325252ull;
+        for (size_t i = 0; i < elems; i++)
+            ListInsertAfterElem(&list, XorShift(&state) % (list.size + 1), (int) i, &pos, &error);
+
+        start = GetTimeNs();
+
+        if (indexed)
+        {
+            ListAttachValueIndex(&list, &error);
+
+            PrintCsvLine(out, "search", layout, sizeof(int), elems, "shuffled", "attach_index", "ns_per_elem",
+                         (GetTimeNs() - start) / (double) elems);
+
+            start = GetTimeNs();
+        }
+
+        // values are unique, so every remove finds its element
+        for (size_t i = 0; i < removes; i++)
+            ListRemoveValue(&list, (int) (i * step), &error);
+        BENCH_SINK = list.size;
+
+        PrintCsvLine(out, "search", layout, sizeof(int), elems, "shuffled",
+                     indexed ? "remove_value_index" : "remove_value_scan", "ns_per_op",
+                     (GetTimeNs() - start) / (double) removes);
+
+        ListDtor(&list);
+    }
+
+    // ----- pages of elements by walk and by rank index -----
+
+    for (int indexed = 0; indexed <= 1; indexed++)
+    {
+        ListCtor(&list, &error);
+
+        // index is attached before inserts, so build time includes its updates
+        if (indexed)
+            ListAttachRankIndex(&list, &error);
+
+        state = 88172645463325252ull;
+        start = GetTimeNs();
+
+        for (size_t i = 0; i < elems; i++)
+            ListInsertAfterElem(&list, XorShift(&state) % (list.size + 1), (int) i, &pos, &error);
+
+        PrintCsvLine(out, "search", layout, sizeof(int), elems, "shuffled",
+                     indexed ? "build_rank_index" : "build", "ns_per_elem",
+                     (GetTimeNs() - start) / (double) elems);
+
+        start = GetTimeNs();
+
+        long long page_sum = 0;
+        for (size_t i = 0; i < PAGE_BENCH_OPS && elems > 0; i++)
+        {
+            size_t cur = GetListPosByIndex(&list, XorShift(&state) % elems);
+
+            for (size_t j = 0; j < PAGE_BENCH_ELEMS && cur != FICTIVE_ELEM_POS; j++, cur = ListNext(&list, cur))
+                page_sum += ListData(&list, cur);
+        }
+        BENCH_SINK = (size_t) page_sum;
+
+        PrintCsvLine(out, "search", layout, sizeof(int), elems, "shuffled",
+                     indexed ? "page_rank_index" : "page_walk", "ns_per_op",
+                     (GetTimeNs() - start) / (double) PAGE_BENCH_OPS);
+
+        ListDtor(&list);
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void RunUnrolledBench(FILE* out, const size_t elems)
+{
+    list_t          list     = {};
+    unrolled_list_t unrolled = {};
+    ErrorInfo       error    = {};
+    size_t          state    = 88172645463325252ull;
+
+    ListCtor(&list, &error);
+    UnrolledListCtor(&unrolled, &error);
+
+    // ----- build by inserts after random elements -----
+
+    double start = GetTimeNs();
+
+    size_t pos = 0;
+    for (size_t i = 0; i < elems; i++)
+        ListInsertAfterElem(&list, XorShift(&state) % (list.size + 1), (int) i, &pos, &error);
+
+    PrintCsvLine(out, "unrolled", "fast_list", sizeof(int), elems, "shuffled", "build", "ns_per_elem",
+                 (GetTimeNs() - start) / (double) elems);
+
+    start = GetTimeNs();
+
+    // blocks are never removed here, so every node before used one holds values
+    UnrolledPos unrolled_pos = {};
+    for (size_t i = 0; i < elems; i++)
+    {
+        size_t node = XorShift(&state) % unrolled.blocks.used;
+
+        if (node != FICTIVE_ELEM_POS)
+            unrolled_pos = {node, XorShift(&state) % (size_t) ListData(&unrolled.blocks, node).amount};
+        else
+            unrolled_pos = {FICTIVE_ELEM_POS, 0};
+
+        UnrolledListInsertAfter(&unrolled, unrolled_pos, (int) i, &unrolled_pos, &error);
+    }
+
+    PrintCsvLine(out, "unrolled", "unrolled_list", sizeof(int), elems, "shuffled", "build", "ns_per_elem",
+                 (GetTimeNs() - start) / (double) elems);
+
+    // ----- traversal in logical order -----
+
+    start = GetTimeNs();
+
+    long long sum = 0;
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+    {
+        for (size_t cur = GetListHead(&list); cur != FICTIVE_ELEM_POS; cur = ListNext(&list, cur))
+            sum += ListData(&list, cur);
+    }
+    BENCH_SINK = (size_t) sum;
+
+    PrintCsvLine(out, "unrolled", "fast_list", sizeof(int), elems, "shuffled", "sum_walk", "ns_per_elem",
+                 (GetTimeNs() - start) / (double) (elems * BENCH_REPEATS));
+
+    start = GetTimeNs();
+
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+    {
+        // values of one block are read without links
+        for (size_t node = GetListHead(&unrolled.blocks); node != FICTIVE_ELEM_POS; node = ListNext(&unrolled.blocks, node))
+        {
+            const unrolled_list_t::block_t* block = &ListData(&unrolled.blocks, node);
+
+            for (int i = 0; i < block->amount; i++)
+                sum += block->values[i];
+        }
+    }
+    BENCH_SINK = (size_t) sum;
+
+    PrintCsvLine(out, "unrolled", "unrolled_list", sizeof(int), elems, "shuffled", "sum_walk", "ns_per_elem",
+                 (GetTimeNs() - start) / (double) (elems * BENCH_REPEATS));
+
+    // ----- inserts at random indices, both lists find position by walk -----
+
+    size_t inserts = (elems < UNROLLED_BENCH_INSERTS) ? elems : UNROLLED_BENCH_INSERTS;
+
+    start = GetTimeNs();
+
+    for (size_t i = 0; i < inserts; i++)
+        ListInsertAfterElem(&list, GetListPosByIndex(&list, XorShift(&state) % list.size), (int) i, &pos, &error);
+
+    PrintCsvLine(out, "unrolled", "fast_list", sizeof(int), elems, "shuffled", "insert_by_index", "ns_per_op",
+                 (GetTimeNs() - start) / (double) inserts);
+
+    start = GetTimeNs();
+
+    for (size_t i = 0; i < inserts; i++)
+        UnrolledListInsertAfter(&unrolled, GetUnrolledListPosByIndex(&unrolled, XorShift(&state) % unrolled.size),
+                                (int) i, &unrolled_pos, &error);
+
+    PrintCsvLine(out, "unrolled", "unrolled_list", sizeof(int), elems, "shuffled", "insert_by_index", "ns_per_op",
+                 (GetTimeNs() - start) / (double) inserts);
+
+    UnrolledListDtor(&unrolled);
+    ListDtor(&list);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void RunStartupBench(FILE* out, const size_t capacity, const bool eager_fill)
+{
+    const char* name  = eager_fill ? "eager_fill" : "lazy";
+
+    list_t    list  = {};
+    ErrorInfo error = {};
+
+    // ----- reserve capacity and take the first slot -----
+
+    size_t rss_before = GetCurrentRssKb();
+    double start      = GetTimeNs();
+
+    if (ListCtor(&list, &error, capacity) != ListErrors::NONE)
+    {
+        fprintf(stderr, "startup: can not reserve %lu slots\n", capacity);
+        return;
+    }
+
+    // baseline threads free list over every slot, as it was done before slots above used were implicitly free
+    if (eager_fill)
+    {
+        for (size_t pos = 1; pos < capacity; pos++)
+        {
+            ListData(&list, pos) = LIST_POISON;
+            ListNext(&list, pos) = (pos + 1 < capacity) ? (int) (CHANGE_SIGN * (int) (pos + 1)) : 0;
+            ListPrev(&list, pos) = -1;
+        }
+    }
+
+    size_t pos = 0;
+    ListInsertBeforeElem(&list, FICTIVE_ELEM_POS, 0, &pos, &error);
+
+    double time      = GetTimeNs() - start;
+    size_t rss_after = GetCurrentRssKb();
+
+    PrintCsvLine(out, "startup", name, sizeof(int), capacity, "sequential", "ctor_first_insert", "total_ns", time);
+    PrintCsvLine(out, "startup", name, sizeof(int), capacity, "sequential", "ctor_first_insert", "rss_before_kb",
+                 (double) rss_before);
+    PrintCsvLine(out, "startup", name, sizeof(int), capacity, "sequential", "ctor_first_insert", "rss_after_kb",
+                 (double) rss_after);
+
+    ListDtor(&list);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void RunWidthBench(FILE* out, const char* width, const size_t elems)
+{
+    ListT     list  = {};
+    ErrorInfo error = {};
+    size_t    state = 88172645463325252ull;
+
+    ListCtor(&list, &error);
+
+    // ----- build by inserts after random elements -----
+
+    double start = GetTimeNs();
+
+    size_t pos = 0;
+    for (size_t i = 0; i < elems; i++)
+        ListInsertAfterElem(&list, XorShift(&state) % (list.size + 1), (int) i, &pos, &error);
+
+    PrintCsvLine(out, "width", width, sizeof(int), elems, "shuffled", "build", "ns_per_elem",
+                 (GetTimeNs() - start) / (double) elems);
+
+    PrintCsvLine(out, "width", width, sizeof(int), elems, "shuffled", "build", "bytes_per_elem",
+                 (double) sizeof(typename ListT::slot_t));
+
+    // ----- traversal in logical order -----
+
+    start = GetTimeNs();
+
+    long long sum = 0;
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+    {
+        for (size_t cur = (size_t) GetListHead(&list); cur != FICTIVE_ELEM_POS; cur = (size_t) ListNext(&list, cur))
+            sum += ListData(&list, cur);
+    }
+    BENCH_SINK = (size_t) sum;
+
+    PrintCsvLine(out, "width", width, sizeof(int), elems, "shuffled", "sum_walk", "ns_per_elem",
+                 (GetTimeNs() - start) / (double) (elems * BENCH_REPEATS));
+
+    ListDtor(&list);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void RunFootprintBench(FILE* out, const char* width, const size_t elems)
+{
+    ListT*    lists = (ListT*) calloc(FOOTPRINT_LISTS, sizeof(ListT));
+    ErrorInfo error = {};
+
+    if (lists == nullptr)
+        return;
+
+    // whole list is its header and everything it allocates, handles and indexes are not taken here
+    size_t heap_start = GetHeapBytes();
+
+    size_t pos = 0;
+    for (size_t i = 0; i < FOOTPRINT_LISTS; i++)
+    {
+        ListCtor(&lists[i], &error);
+
+        for (size_t elem = 0; elem < elems; elem++)
+            ListInsertBeforeElem(&lists[i], FICTIVE_ELEM_POS, (int) elem, &pos, &error);
+    }
+
+    double heap_bytes = (double) (GetHeapBytes() - heap_start) / (double) FOOTPRINT_LISTS;
+
+    PrintCsvLine(out, "width", width, sizeof(int), elems, "sequential", "small_list", "header_bytes",
+                 (double) sizeof(ListT));
+    PrintCsvLine(out, "width", width, sizeof(int), elems, "sequential", "small_list", "footprint_bytes",
+                 (double) sizeof(ListT) + heap_bytes);
+
+    for (size_t i = 0; i < FOOTPRINT_LISTS; i++)
+        ListDtor(&lists[i]);
+
+    free(lists);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void RunWrappersBench(FILE* out, const size_t elems)
+{
+    size_t list_elems = (elems + WRAPPED_LISTS - 1) / WRAPPED_LISTS;
+
+    // ----- lists are returned by value and moved into vector, which moves them again when it grows -----
+
+    double start = GetTimeNs();
+
+    std::vector<ListWrapper<>> lists;
+    for (size_t i = 0; i < WRAPPED_LISTS; i++)
+    {
+        ListWrapper<> list = MakeWrappedList(list_elems);
+        lists.push_back(std::move(list));
+
+        // moved out list has no storage, its destructor frees nothing
+        BENCH_SINK += list.Size();
+    }
+
+    PrintCsvLine(out, "wrappers", "list_wrapper", sizeof(int), list_elems * WRAPPED_LISTS, "sequential", "build",
+                 "ns_per_elem", (GetTimeNs() - start) / (double) (list_elems * WRAPPED_LISTS));
+
+    // ----- range-for over wrapper vs walk by ListNext, both have to take the same time -----
+
+    start = GetTimeNs();
+
+    long long wrapper_sum = 0;
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+    {
+        for (const ListWrapper<>& list : lists)
+        {
+            for (int value : list)
+                wrapper_sum += value;
+        }
+    }
+
+    PrintCsvLine(out, "wrappers", "list_wrapper", sizeof(int), list_elems * WRAPPED_LISTS, "sequential", "range_for",
+                 "ns_per_elem", (GetTimeNs() - start) / (double) (list_elems * WRAPPED_LISTS * BENCH_REPEATS));
+
+    start = GetTimeNs();
+
+    long long raw_sum = 0;
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+    {
+        for (const ListWrapper<>& wrapped : lists)
+        {
+            const list_t* list = wrapped.Get();
+
+            for (size_t cur = (size_t) GetListHead(list); cur != FICTIVE_ELEM_POS; cur = (size_t) ListNext(list, cur))
+                raw_sum += ListData(list, cur);
+        }
+    }
+
+    PrintCsvLine(out, "wrappers", "fast_list", sizeof(int), list_elems * WRAPPED_LISTS, "sequential", "link_walk",
+                 "ns_per_elem", (GetTimeNs() - start) / (double) (list_elems * WRAPPED_LISTS * BENCH_REPEATS));
+
+    if (wrapper_sum != raw_sum)
+        fprintf(stderr, "wrappers: range-for sum %lld differs from walk sum %lld\n", wrapper_sum, raw_sum);
+
+    BENCH_SINK += (size_t) raw_sum;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static ListWrapper<> MakeWrappedList(const size_t elems)
+{
+    ListWrapper<> list;
+
+    for (size_t i = 0; i < elems; i++)
+        list.PushBack((int) i);
+
+    return list;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void RunXorBench(FILE* out, const size_t elems)
+{
+    list_t     list     = {};
+    xor_list_t xor_list = {};
+    ErrorInfo  error    = {};
+
+    ListCtor(&list, &error);
+    XorListCtor(&xor_list, &error);
+
+    // ----- queue: appends, then every pop of the head is followed by push back -----
+
+    double start = GetTimeNs();
+
+    size_t pos = 0;
+    for (size_t i = 0; i < elems; i++)
+        ListInsertBeforeElem(&list, FICTIVE_ELEM_POS, (int) i, &pos, &error);
+
+    for (size_t i = 0; i < elems; i++)
+    {
+        ListRemoveElem(&list, (size_t) GetListHead(&list), &error);
+        ListInsertBeforeElem(&list, FICTIVE_ELEM_POS, (int) i, &pos, &error);
+    }
+
+    PrintCsvLine(out, "xor", "fast_list", sizeof(int), elems, "queue", "push_pop", "ns_per_op",
+                 (GetTimeNs() - start) / (double) (3 * elems));
+
+    start = GetTimeNs();
+
+    XorListCursor cursor = {};
+    for (size_t i = 0; i < elems; i++)
+        XorListInsertBefore(&xor_list, GetXorListEnd(&xor_list), (int) i, &cursor, &error);
+
+    for (size_t i = 0; i < elems; i++)
+    {
+        XorListRemove(&xor_list, GetXorListBegin(&xor_list), &cursor, &error);
+        XorListInsertBefore(&xor_list, GetXorListEnd(&xor_list), (int) i, &cursor, &error);
+    }
+
+    PrintCsvLine(out, "xor", "xor_list", sizeof(int), elems, "queue", "push_pop", "ns_per_op",
+                 (GetTimeNs() - start) / (double) (3 * elems));
+
+    PrintCsvLine(out, "xor", "fast_list", sizeof(int), elems, "queue", "build", "bytes_per_elem",
+                 (double) sizeof(list_t::slot_t));
+    PrintCsvLine(out, "xor", "xor_list", sizeof(int), elems, "queue", "build", "bytes_per_elem",
+                 (double) sizeof(xor_list_t::slot_t));
+
+    // ----- traversal in logical order -----
+
+    start = GetTimeNs();
+
+    long long sum = 0;
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+    {
+        for (size_t cur = (size_t) GetListHead(&list); cur != FICTIVE_ELEM_POS; cur = (size_t) ListNext(&list, cur))
+            sum += ListData(&list, cur);
+    }
+    BENCH_SINK = (size_t) sum;
+
+    PrintCsvLine(out, "xor", "fast_list", sizeof(int), elems, "queue", "sum_walk", "ns_per_elem",
+                 (GetTimeNs() - start) / (double) (elems * BENCH_REPEATS));
+
+    start = GetTimeNs();
+
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+    {
+        for (cursor = GetXorListBegin(&xor_list); cursor.cur != FICTIVE_ELEM_POS;
+             cursor = GetXorListNext(&xor_list, cursor))
+            sum += XorListData(&xor_list, cursor);
+    }
+    BENCH_SINK = (size_t) sum;
+
+    PrintCsvLine(out, "xor", "xor_list", sizeof(int), elems, "queue", "sum_walk", "ns_per_elem",
+                 (GetTimeNs() - start) / (double) (elems * BENCH_REPEATS));
+
+    XorListDtor(&xor_list);
+    ListDtor(&list);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void RunLogsBench(FILE* out, const size_t records)
+{
+    OpenLogFile("bench");
+
+    // record like the ones, which are printed by list functions
+    const char* format = "RUNNING FUNCTION %s FROM FILE \"%s\"(%d)<br>\n";
+
+    int    record_len = snprintf(nullptr, 0, format, __func__, __FILE__, __LINE__);
+    double start      = GetTimeNs();
+    double cpu_start  = GetThreadCpuTimeNs();
+
+    for (size_t i = 0; i < records; i++)
+        PrintLog(format, __func__, __FILE__, __LINE__);
+
+    double printed     = GetTimeNs();
+    double cpu_printed = GetThreadCpuTimeNs();
+
+    FlushLog();
+
+    double flushed = GetTimeNs();
+
+    // on one core flusher steals time of caller, thread cpu time shows cost of record itself
+    PrintCsvLine(out, "logs", "print_log", (size_t) record_len, records, "sequential", "print", "ns_per_op",
+                 (printed - start) / (double) records);
+    PrintCsvLine(out, "logs", "print_log", (size_t) record_len, records, "sequential", "print",
+                 "caller_cpu_ns_per_op", (cpu_printed - cpu_start) / (double) records);
+    PrintCsvLine(out, "logs", "print_log", (size_t) record_len, records, "sequential", "print_and_flush",
+                 "ns_per_op", (flushed - start) / (double) records);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+// same operations over every compared list, errors are not checked in optimized build
+
+static inline size_t BenchPushBack(list_t* list, const int value)
+{
+    size_t pos = 0;
+    ListInsertBeforeElem(list, FICTIVE_ELEM_POS, value, &pos, &BENCH_ERROR);
+
+    return pos;
+}
+
+static inline size_t BenchInsertAfter(list_t* list, const size_t pos, const int value)
+{
+    size_t inserted_pos = 0;
+    ListInsertAfterElem(list, pos, value, &inserted_pos, &BENCH_ERROR);
+
+    return inserted_pos;
+}
+
+static inline void BenchRemove(list_t* list, const size_t pos)
+{
+    ListRemoveElem(list, pos, &BENCH_ERROR);
+}
+
+static inline int BenchGet(list_t* list, const size_t pos)
+{
+    int value = 0;
+    GetListElement(list, pos, &value, &BENCH_ERROR);
+
+    return value;
+}
+
+static inline size_t BenchSum(list_t* list)
+{
+    size_t sum = 0;
+    for (size_t cur = (size_t) GetListHead(list); cur != FICTIVE_ELEM_POS; cur = (size_t) ListNext(list, cur))
+        sum += (size_t) ListData(list, cur);
+
+    return sum;
+}
+
+static inline void BenchCtor(list_t* list)  { ListCtor(list, &BENCH_ERROR); }
+static inline void BenchDtor(list_t* list)  { ListDtor(list); }
+
+//-----------------------------------------------------------------------------------------------------
+
+static inline PtrListElem* BenchPushBack(ptrlist_t* list, const int value)
+{
+    PtrListElem* pos = nullptr;
+    PtrListInsertBeforeElem(list, list->fictive, value, &pos, &BENCH_ERROR);
+
+    return pos;
+}
+
+static inline PtrListElem* BenchInsertAfter(ptrlist_t* list, PtrListElem* pos, const int value)
+{
+    PtrListElem* inserted_pos = nullptr;
+    PtrListInsertAfterElem(list, pos, value, &inserted_pos, &BENCH_ERROR);
+
+    return inserted_pos;
+}
+
+static inline void BenchRemove(ptrlist_t* list, PtrListElem* pos)
+{
+    PtrListRemoveElem(list, pos, &BENCH_ERROR);
+}
+
+static inline int BenchGet(ptrlist_t* list, PtrListElem* pos)
+{
+    int value = 0;
+    GetPtrListElem(list, pos, &value, &BENCH_ERROR);
+
+    return value;
+}
+
+static inline size_t BenchSum(ptrlist_t* list)
+{
+    size_t sum = 0;
+    for (PtrListElem* cur = list->fictive->next; cur != list->fictive; cur = cur->next)
+        sum += (size_t) cur->data;
+
+    return sum;
+}
+
+static inline void BenchCtor(ptrlist_t* list)   { PtrListCtor(list, &BENCH_ERROR); }
+static inline void BenchDtor(ptrlist_t* list)   { PtrListDtor(list); }
+
+//-----------------------------------------------------------------------------------------------------
+
+static inline stdlist_t::iterator BenchPushBack(stdlist_t* list, const int value)
+{
+    list->push_back(value);
+
+    return std::prev(list->end());
+}
+
+static inline stdlist_t::iterator BenchInsertAfter(stdlist_t* list, stdlist_t::iterator pos, const int value)
+{
+    return list->insert(std::next(pos), value);
+}
+
+static inline void BenchRemove(stdlist_t* list, stdlist_t::iterator pos)
+{
+    list->erase(pos);
+}
+
+static inline int BenchGet(stdlist_t* /* list */, stdlist_t::iterator pos)
+{
+    return *pos;
+}
+
+static inline size_t BenchSum(stdlist_t* list)
+{
+    size_t sum = 0;
+    for (int value : *list)
+        sum += (size_t) value;
+
+    return sum;
+}
+
+static inline void BenchCtor(stdlist_t* /* list */)     {}
+static inline void BenchDtor(stdlist_t* list)           { list->clear(); }
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void RunListsBenchIsolated(FILE* out, const char* name, const size_t elems)
+{
+    // every run gets fresh heap, so rss of one list does not include memory left by another
+    fflush(out);
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        RunListsBench<ListT>(out, name, elems);
+        return;
+    }
+
+    if (pid == 0)
+    {
+        RunListsBench<ListT>(out, name, elems);
+        fflush(out);
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    if (WIFSIGNALED(status))
+        fprintf(stderr, "lists: %s with %lu elements was killed by signal %d (out of memory?)\n",
+                        name, elems, WTERMSIG(status));
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void PrintListsResult(FILE* out, const char* name, const size_t elems, const char* order,
+                             const char* operation, const size_t ops, const double time,
+                             CacheCounter* counter)
+{
+    long long misses = StopCacheCounter(counter);
+
+    PrintCsvLine(out, "lists", name, sizeof(int), elems, order, operation, "ns_per_op",
+                 time / (double) ops);
+
+    // counter is not available without permissions or in virtual machines
+    if (misses >= 0)
+        PrintCsvLine(out, "lists", name, sizeof(int), elems, order, operation, "cache_misses_per_op",
+                     (double) misses / (double) ops);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void RunListsBench(FILE* out, const char* name, const size_t elems)
+{
+    typedef typename BenchHandle<ListT>::type handle_t;
+
+    ListT        list    = {};
+    size_t       state   = 88172645463325252ull;
+    CacheCounter counter = {};
+
+    size_t    handles_cap = (elems < MAX_BENCH_HANDLES) ? 2 * elems : MAX_BENCH_HANDLES;
+    size_t    handles_amt = 0;
+    handle_t* handles     = (handle_t*) malloc(handles_cap * sizeof(handle_t));
+    assert(handles);
+
+    // pages of handles are touched now, so they are not counted in rss of the list
+    // (filling with zeros can be turned into calloc by compiler, which does not touch pages)
+    memset((void*) handles, 0xFF, handles_cap * sizeof(handle_t));
+
+    size_t ops       = (elems < MAX_RANDOM_OPS) ? elems : MAX_RANDOM_OPS;
+    size_t rss_start = GetCurrentRssKb();
+
+    BenchCtor(&list);
+
+    // ----- push back, handles are reservoir sample of all elements -----
+
+    StartCacheCounter(&counter);
+    double start = GetTimeNs();
+
+    for (size_t i = 0; i < elems; i++)
+    {
+        handle_t pos = BenchPushBack(&list, (int) i);
+
+        if (handles_amt < handles_cap)
+            handles[handles_amt++] = pos;
+        else
+        {
+            size_t victim = XorShift(&state) % (i + 1);
+            if (victim < handles_cap)
+                handles[victim] = pos;
+        }
+    }
+
+    PrintListsResult(out, name, elems, "sequential", "push_back", elems, GetTimeNs() - start, &counter);
+
+    PrintCsvLine(out, "lists", name, sizeof(int), elems, "sequential", "push_back", "rss_kb",
+                 (double) (GetCurrentRssKb() - rss_start));
+
+    // ----- traversal -----
+
+    StartCacheCounter(&counter);
+    start = GetTimeNs();
+
+    BENCH_SINK = BenchSum(&list);
+
+    PrintListsResult(out, name, elems, "sequential", "traverse", elems, GetTimeNs() - start, &counter);
+
+    // ----- insert after random elements -----
+
+    StartCacheCounter(&counter);
+    start = GetTimeNs();
+
+    for (size_t i = 0; i < ops; i++)
+    {
+        size_t   index = XorShift(&state) % handles_amt;
+        handle_t pos   = BenchInsertAfter(&list, handles[index], (int) i);
+
+        if (handles_amt < handles_cap)
+            handles[handles_amt++] = pos;
+        else
+            handles[index] = pos;
+    }
+
+    PrintListsResult(out, name, elems, "random", "insert", ops, GetTimeNs() - start, &counter);
+
+    // ----- remove random elements -----
+
+    size_t removes = (ops < handles_amt) ? ops : handles_amt;
+
+    StartCacheCounter(&counter);
+    start = GetTimeNs();
+
+    for (size_t i = 0; i < removes; i++)
+    {
+        size_t index = XorShift(&state) % handles_amt;
+
+        BenchRemove(&list, handles[index]);
+        handles[index] = handles[--handles_amt];
+    }
+
+    PrintListsResult(out, name, elems, "random", "remove", removes, GetTimeNs() - start, &counter);
+
+    // ----- mixed: 40% inserts, 40% removes, 20% reads -----
+
+    StartCacheCounter(&counter);
+    start = GetTimeNs();
+
+    size_t sum = 0;
+    for (size_t i = 0; i < ops; i++)
+    {
+        size_t dice  = XorShift(&state) % 10;
+        size_t index = (handles_amt > 0) ? XorShift(&state) % handles_amt : 0;
+
+        if (dice < 4 || handles_amt == 0)
+        {
+            handle_t pos = (handles_amt > 0) ? BenchInsertAfter(&list, handles[index], (int) i) :
+                                               BenchPushBack(&list, (int) i);
+
+            if (handles_amt < handles_cap)
+                handles[handles_amt++] = pos;
+            else
+                handles[index] = pos;
+        }
+        else if (dice < 8)
+        {
+            BenchRemove(&list, handles[index]);
+            handles[index] = handles[--handles_amt];
+        }
+        else
+            sum += (size_t) BenchGet(&list, handles[index]);
+    }
+    BENCH_SINK = sum;
+
+    PrintListsResult(out, name, elems, "random", "mixed", ops, GetTimeNs() - start, &counter);
+
+    free(handles);
+    BenchDtor(&list);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void RunConcurrentBench(FILE* out, const size_t threads_amt, const size_t ops)
+{
+    assert(threads_amt > 0);
+
+    // every thread takes batch of slots and gives it back, so list grows only at the start
+    size_t batches = ops / (threads_amt * CONCURRENT_BENCH_BATCH);
+    if (batches == 0)
+        batches = 1;
+
+    size_t done_ops = batches * threads_amt * CONCURRENT_BENCH_BATCH;
+
+    char order[32] = "";
+    snprintf(order, sizeof(order), "%zu_threads", threads_amt);
+
+    std::thread* threads = new std::thread[threads_amt];
+
+    // ----- lock-free reservations -----
+
+    chunked_list_t      list  = {};
+    ListConcurrentSlots slots = {};
+    ErrorInfo           error = {};
+
+    ListCtor(&list, &error);
+    ListStartConcurrentSlots(&list, &slots);
+
+    double start = GetTimeNs();
+
+    for (size_t i = 0; i < threads_amt; i++)
+        threads[i] = std::thread(ReserveSlotsWorker, &list, &slots, batches);
+    for (size_t i = 0; i < threads_amt; i++)
+        threads[i].join();
+
+    PrintCsvLine(out, "concurrent", "reserve_slot", sizeof(int), done_ops, order, "reserve_release",
+                 "ns_per_op", (GetTimeNs() - start) / (double) done_ops);
+
+    ListStopConcurrentSlots(&list, &slots);
+    ListDtor(&list);
+
+    // ----- inserts under one mutex -----
+
+    std::mutex lock;
+
+    list = {};
+    ListCtor(&list, &error);
+
+    start = GetTimeNs();
+
+    for (size_t i = 0; i < threads_amt; i++)
+        threads[i] = std::thread(LockedInsertsWorker, &list, &lock, batches);
+    for (size_t i = 0; i < threads_amt; i++)
+        threads[i].join();
+
+    PrintCsvLine(out, "concurrent", "mutex_insert", sizeof(int), done_ops, order, "insert_remove",
+                 "ns_per_op", (GetTimeNs() - start) / (double) done_ops);
+
+    ListDtor(&list);
+
+    // ----- appends into own shards and merge of them -----
+
+    ShardedList<list_t> sharded = {};
+    list_t              merged  = {};
+
+    ShardedListCtor(&sharded, threads_amt, &error);
+
+    start = GetTimeNs();
+
+    for (size_t i = 0; i < threads_amt; i++)
+        threads[i] = std::thread(ShardAppendsWorker, &sharded, i, done_ops / threads_amt);
+    for (size_t i = 0; i < threads_amt; i++)
+        threads[i].join();
+
+    PrintCsvLine(out, "concurrent", "sharded_list", sizeof(int), done_ops, order, "append",
+                 "ns_per_op", (GetTimeNs() - start) / (double) done_ops);
+
+    start = GetTimeNs();
+
+    ShardedListMerge(&sharded, &merged, &error);
+
+    PrintCsvLine(out, "concurrent", "sharded_list", sizeof(int), done_ops, order, "merge",
+                 "ns_per_op", (GetTimeNs() - start) / (double) done_ops);
+
+    ListDtor(&merged);
+    ShardedListDtor(&sharded);
+
+    delete [] threads;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void ReserveSlotsWorker(chunked_list_t* list, ListConcurrentSlots* slots, const size_t batches)
+{
+    assert(list);
+    assert(slots);
+
+    ErrorInfo error = {};
+    size_t    taken[CONCURRENT_BENCH_BATCH] = {};
+
+    for (size_t batch = 0; batch < batches; batch++)
+    {
+        for (size_t i = 0; i < CONCURRENT_BENCH_BATCH; i++)
+            ListReserveSlot(list, slots, (int) i, &taken[i], &error);
+
+        for (size_t i = 0; i < CONCURRENT_BENCH_BATCH; i++)
+            ListReleaseSlot(list, slots, taken[i]);
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void LockedInsertsWorker(chunked_list_t* list, std::mutex* lock, const size_t batches)
+{
+    assert(list);
+    assert(lock);
+
+    ErrorInfo error = {};
+    size_t    taken[CONCURRENT_BENCH_BATCH] = {};
+
+    for (size_t batch = 0; batch < batches; batch++)
+    {
+        for (size_t i = 0; i < CONCURRENT_BENCH_BATCH; i++)
+        {
+            std::lock_guard<std::mutex> guard(*lock);
+            ListInsertBeforeElem(list, FICTIVE_ELEM_POS, (int) i, &taken[i], &error);
+        }
+
+        for (size_t i = 0; i < CONCURRENT_BENCH_BATCH; i++)
+        {
+            std::lock_guard<std::mutex> guard(*lock);
+            ListRemoveElem(list, taken[i], &error);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void ShardAppendsWorker(ShardedList<list_t>* sharded, const size_t shard, const size_t appends)
+{
+    assert(sharded);
+
+    ErrorInfo error = {};
+    size_t    pos   = 0;
+
+    for (size_t i = 0; i < appends; i++)
+        ShardedListAppend(sharded, shard, (int) i, &pos, &error);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static int CompareFloats(const void* first, const void* second)
+{
+    float first_val  = *(const float*) first;
+    float second_val = *(const float*) second;
+
+    return (first_val > second_val) - (first_val < second_val);
+}
+
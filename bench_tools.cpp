@@ -0,0 +1,152 @@
+#include <assert.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <malloc.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "bench_tools.h"
+
+double GetTimeNs()
+{
+    struct timespec time = {};
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (double) time.tv_sec * 1e9 + (double) time.tv_nsec;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+double GetThreadCpuTimeNs()
+{
+    struct timespec time = {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+
+    return (double) time.tv_sec * 1e9 + (double) time.tv_nsec;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+size_t XorShift(size_t* state)
+{
+    assert(state);
+
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+
+    return *state;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+size_t GetCurrentRssKb()
+{
+#ifdef __linux__
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (statm == nullptr)
+        return 0;
+
+    size_t total_pages    = 0;
+    size_t resident_pages = 0;
+
+    if (fscanf(statm, "%lu %lu", &total_pages, &resident_pages) != 2)
+        resident_pages = 0;
+
+    fclose(statm);
+
+    return resident_pages * (size_t) sysconf(_SC_PAGESIZE) / 1024;
+#else
+    //          v------ only peak memory is available, it is in bytes on macOS
+    struct rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+
+    return (size_t) usage.ru_maxrss / 1024;
+#endif
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+size_t GetHeapBytes()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+void StartCacheCounter(CacheCounter* counter)
+{
+    assert(counter);
+
+    counter->fd = -1;
+
+#ifdef __linux__
+    struct perf_event_attr attr = {};
+
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+
+    counter->fd = (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (counter->fd < 0)
+        return;
+
+    ioctl(counter->fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(counter->fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+long long StopCacheCounter(CacheCounter* counter)
+{
+    assert(counter);
+
+    if (counter->fd < 0)
+        return -1;
+
+    long long misses = -1;
+
+#ifdef __linux__
+    ioctl(counter->fd, PERF_EVENT_IOC_DISABLE, 0);
+
+    if (read(counter->fd, &misses, sizeof(misses)) != sizeof(misses))
+        misses = -1;
+#endif
+
+    close(counter->fd);
+    counter->fd = -1;
+
+    return misses;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+void PrintCsvHeader(FILE* out)
+{
+    fprintf(out, "suite,list,payload_bytes,elements,order,operation,metric,value\n");
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+void PrintCsvLine(FILE* out, const char* suite, const char* list, const size_t payload,
+                  const size_t elems, const char* order, const char* operation,
+                  const char* metric, const double value)
+{
+    fprintf(out, "%s,%s,%lu,%lu,%s,%s,%s,%.3lf\n", suite, list, payload, elems, order, operation,
+                                                  metric, value);
+}
@@ -0,0 +1,92 @@
+#ifndef __BENCH_TOOLS_H_
+#define __BENCH_TOOLS_H_
+
+/*! \file
+* \brief Contains timers, memory and cache counters for benchmarks
+*/
+
+#include <stdio.h>
+
+/// hardware cache misses counter, it is not available on every system
+struct CacheCounter
+{
+    int fd;
+};
+
+/************************************************************//**
+ * @brief Gets monotonic time
+ *
+ * @return double time in nanoseconds
+ ************************************************************/
+double GetTimeNs();
+
+/************************************************************//**
+ * @brief Gets cpu time of current thread, it does not include
+ * time of other threads, even if they run on the same core
+ *
+ * @return double time in nanoseconds
+ ************************************************************/
+double GetThreadCpuTimeNs();
+
+/************************************************************//**
+ * @brief Fast pseudo random generator
+ *
+ * @param[in] state generator state, must not be zero
+ * @return size_t random number
+ ************************************************************/
+size_t XorShift(size_t* state);
+
+/************************************************************//**
+ * @brief Gets resident memory of process
+ *
+ * @return size_t current resident memory in kilobytes
+ ************************************************************/
+size_t GetCurrentRssKb();
+
+/************************************************************//**
+ * @brief Gets heap memory, which is allocated by malloc now
+ *
+ * @return size_t allocated bytes, 0 if allocator does not tell them
+ ************************************************************/
+size_t GetHeapBytes();
+
+/************************************************************//**
+ * @brief Opens and starts cache misses counter
+ *
+ * @param[out] counter counter
+ ************************************************************/
+void StartCacheCounter(CacheCounter* counter);
+
+/************************************************************//**
+ * @brief Stops and closes cache misses counter
+ *
+ * @param[in] counter counter
+ * @return long long amount of cache misses, -1 if counter is not available
+ ************************************************************/
+long long StopCacheCounter(CacheCounter* counter);
+
+/************************************************************//**
+ * @brief Prints csv header
+ *
+ * @param[in] out output stream
+ ************************************************************/
+void PrintCsvHeader(FILE* out);
+
+/************************************************************//**
+ * @brief Prints one measured value as csv line
+ *
+ * @param[in] out output stream
+ * @param[in] suite benchmark suite
+ * @param[in] list list type
+ * @param[in] payload element size in bytes
+ * @param[in] elems amount of elements
+ * @param[in] order how list was built
+ * @param[in] operation measured operation
+ * @param[in] metric measured value name
+ * @param[in] value measured value
+ ************************************************************/
+void PrintCsvLine(FILE* out, const char* suite, const char* list, const size_t payload,
+                  const size_t elems, const char* order, const char* operation,
+                  const char* metric, const double value);
+
+#endif
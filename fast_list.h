@@ -1,24 +1,242 @@
 #ifndef __FAST_LIST_H_
 #define __FAST_LIST_H_
 
+#include <stdlib.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <limits>
+#include <type_traits>
+
 #include "errors.h"
+#include "list_simd.h"
+
+static const int    LIST_POISON      = -2147483647;
+static const int    CHANGE_SIGN      = -1;
+static const size_t FICTIVE_ELEM_POS =  0;
+
+static const size_t LIST_CHUNK_SHIFT = 12;
+static const size_t LIST_CHUNK_ELEMS = 1 << LIST_CHUNK_SHIFT;
+static const size_t LIST_CHUNK_MASK  = LIST_CHUNK_ELEMS - 1;
+///                                         v------ every int index can be reached, wider indices are limited by it too
+static const size_t MAX_LIST_CHUNKS  = (1ul << 31) / LIST_CHUNK_ELEMS;
 
+/// links are signed: free slots keep negated next free slot, so every width uses the same encoding
+template <typename T, typename IndexT = int>
 struct ListElem
 {
-    int data;
-    int next;
-    int prev;
+    T      data;
+    IndexT next;
+    IndexT prev;
+};
+
+/// how elements are placed in memory, chosen at compile time
+enum class ListLayout
+{
+    AOS,    ///< one array of {data, next, prev} elements
+    SOA,    ///< separate aligned data, next and prev arrays
+    CHUNKED ///< {data, next, prev} elements in fixed size chunks, which are never moved
+};
+
+template <typename T, ListLayout layout, typename IndexT>
+struct ListStorage;
+
+template <typename T, typename IndexT>
+struct ListStorage<T, ListLayout::AOS, IndexT>
+{
+    ListElem<T, IndexT>* elems;
+};
+
+template <typename T, typename IndexT>
+struct ListStorage<T, ListLayout::SOA, IndexT>
+{
+    T*      data;
+    IndexT* next;
+    IndexT* prev;
+};
+
+template <typename T, typename IndexT>
+struct ListStorage<T, ListLayout::CHUNKED, IndexT>
+{
+    /// directory grows geometrically, replaced directories are kept until storage is freed,
+    /// so thread, which still reads old one, reaches the same chunks
+    ListElem<T, IndexT>** chunks;
+    size_t                chunks_capacity;
 };
 
-struct List
+/// how much list operations check their arguments, chosen at compile time
+enum class ListChecks
 {
+    UNCHECKED,  ///< no checks at all, wrong positions are undefined behaviour
+    LIGHT,      ///< O(1) checks of list header and positions
+    PARANOID    ///< light checks and walk over all links before every change
+};
+
+#ifdef _DEBUG
+static const ListChecks DEFAULT_LIST_CHECKS = ListChecks::PARANOID;
+#else
+static const ListChecks DEFAULT_LIST_CHECKS = ListChecks::LIGHT;
+#endif
 
-    ListElem* elems;
+/// entry of value index, slot 0 marks empty entry
+struct ListIndexEntry
+{
+    unsigned hash;      ///< low half of value hash, it also gives home bucket of entry
+    int      slot;
+};
 
-    int free;
+/// open addressing table: value -> slots of elements with it, linear probing without tombstones
+struct ListValueIndex
+{
+    ListIndexEntry* entries;    ///< nullptr while index is not attached
+    size_t          capacity;   ///< power of two
+    size_t          size;
+};
+
+/// node of order statistic tree, node of element is stored in its slot, slot 0 is null node
+struct ListRankNode
+{
+    int      left;
+    int      right;
+    int      parent;
+    int      count;         ///< amount of nodes in subtree, 0 for null node
+    unsigned priority;      ///< treap: priority of parent is not less than priorities of its children
+};
+
+/// balanced tree over slots, its in-order is logical order of list
+struct ListRankIndex
+{
+    ListRankNode*      nodes;       ///< nullptr while index is not attached
+    size_t             capacity;
+    int                root;
+    unsigned long long seed;        ///< state of priorities generator
+};
+
+/// optional parts of the list, they are allocated together, when the first of them is used
+struct ListExtras
+{
+    /// generation of every slot, it grows when element leaves slot, allocated with first handle
+    unsigned* generations;
+    size_t    generations_capacity;
+
+    /// optional index of values, it is changed by inserts and removes and rebuilt by compactions
+    ListValueIndex value_index;
+
+    /// optional index of positions, it is changed by inserts and removes and rebuilt by compactions
+    ListRankIndex  rank_index;
+};
+
+/// IndexT is type of links: int16_t for tiny lists, int by default, int64_t for lists with more than 2^31 slots
+template <typename T, ListLayout layout = ListLayout::AOS, ListChecks checks = DEFAULT_LIST_CHECKS,
+          typename IndexT = int>
+struct FastList : ListStorage<T, layout, IndexT>
+{
+    static_assert(std::is_integral<IndexT>::value && std::is_signed<IndexT>::value,
+                  "free slots are marked by negative links");
+    static_assert(layout != ListLayout::CHUNKED || (size_t) std::numeric_limits<IndexT>::max() >= LIST_CHUNK_ELEMS,
+                  "index has to reach every slot of chunk");
+
+    typedef T                               data_t;
+    typedef IndexT                          index_t;
+    typedef ListElem<T, IndexT>             slot_t;
+    typedef ListStorage<T, layout, IndexT>  storage_t;
+
+    static const ListLayout LAYOUT = layout;
+
+#ifdef _DEBUG
+    /// debug build always verifies everything
+    static const ListChecks CHECKS = ListChecks::PARANOID;
+#else
+    static const ListChecks CHECKS = checks;
+#endif
+
+    IndexT free;
+
+    /// physical order equals logical order, i-th element is in slot i + 1
+    bool linearized;
 
     size_t capacity;
     size_t size;
+
+    /// slots from used to capacity were never taken and are free without being filled,
+    /// free list ends with slot used (or with fictive element, if it is equal to capacity)
+    size_t used;
+
+    /// nullptr while list has no handles and no indexes, so small lists stay small
+    ListExtras* extras;
+};
+
+/// stable reference to element: generation of slot in high half, slot in low half
+typedef unsigned long long list_handle_t;
+
+static const list_handle_t LIST_NULL_HANDLE = 0;    ///< handle of fictive element, it is never valid
+
+// element accessors, they hide layout of the list
+
+/// directory of chunked list can be replaced by thread, which reserves slots concurrently, entries of old one stay valid
+template <class ListT>
+inline auto GetListChunks(ListT* list)
+{
+    return __atomic_load_n(&list->chunks, __ATOMIC_ACQUIRE);
+}
+
+template <class ListT>
+inline auto& ListData(ListT* list, const size_t pos)
+{
+    if constexpr (ListT::LAYOUT == ListLayout::AOS)
+        return list->elems[pos].data;
+    else if constexpr (ListT::LAYOUT == ListLayout::SOA)
+        return list->data[pos];
+    else
+        return GetListChunks(list)[pos >> LIST_CHUNK_SHIFT][pos & LIST_CHUNK_MASK].data;
+}
+
+template <class ListT>
+inline auto& ListNext(ListT* list, const size_t pos)
+{
+    if constexpr (ListT::LAYOUT == ListLayout::AOS)
+        return list->elems[pos].next;
+    else if constexpr (ListT::LAYOUT == ListLayout::SOA)
+        return list->next[pos];
+    else
+        return GetListChunks(list)[pos >> LIST_CHUNK_SHIFT][pos & LIST_CHUNK_MASK].next;
+}
+
+template <class ListT>
+inline auto& ListPrev(ListT* list, const size_t pos)
+{
+    if constexpr (ListT::LAYOUT == ListLayout::AOS)
+        return list->elems[pos].prev;
+    else if constexpr (ListT::LAYOUT == ListLayout::SOA)
+        return list->prev[pos];
+    else
+        return GetListChunks(list)[pos >> LIST_CHUNK_SHIFT][pos & LIST_CHUNK_MASK].prev;
+}
+
+/// value written into data of free and fictive elements, if type has one
+template <typename T>
+struct ListPoison
+{
+    static const bool ENABLED = false;
+
+    static T Value() { return T(); }
+};
+
+template <>
+struct ListPoison<int>
+{
+    static const bool ENABLED = true;
+
+    static int Value() { return LIST_POISON; }
+};
+
+/// lock-free allocation of slots of chunked list, free list of the list belongs to it while it is started
+struct ListConcurrentSlots
+{
+    std::atomic<unsigned long long> free_top;   ///< ABA tag in high half, top free slot in low half
+    std::atomic<size_t>             used;
+    std::atomic<size_t>             capacity;
+    std::atomic<bool>               growing;    ///< only one thread allocates new chunk
 };
 
 enum class ListErrors
@@ -29,11 +247,21 @@ enum class ListErrors
     EMPTY_LIST,
     EMPTY_ELEMENT,
     INVALID_SIZE,
+    INVALID_INDEX,
     DAMAGED_FICTIVE,
+    DAMAGED_LINKS,
+    STALE_HANDLE,
+    MISSING_VALUE,
+    INDEX_OVERFLOW,
+    INVALID_CURSOR,
 
     UNKNOWN
 };
 
+typedef FastList<int> List;
+typedef List          list_t;
+
+template <class ListT = list_t>
 int PrintListError(FILE* fp, const void* err, const char* func, const char* file, const int line);
 
 #ifdef EXIT_IF_LISTERROR
@@ -58,34 +286,234 @@ int PrintListError(FILE* fp, const void* err, const char* func, const char* file
                                                 }                                                       \
                                             } while(0)
 
+static const size_t DEFAULT_LIST_CAPACITY = 16;
 
-typedef struct List list_t;
+static const size_t MAX_FULL_DUMP_CAPACITY = 1024;   ///< bigger lists are dumped by ends by default
+static const size_t DEFAULT_DUMPED_ENDS    = 16;
+static const size_t MAX_DUMPED_SLOTS       = 256;
 
-static const size_t DEFAULT_LIST_CAPACITY = 16;
-ListErrors MakeListShorter(list_t* list, const size_t new_capacity, ErrorInfo* error);
+/// which part of the list is dumped
+enum class ListDumpMode
+{
+    FULL,       ///< every slot of the list
+    WINDOW,     ///< slots from pos - amount to pos + amount
+    ENDS,       ///< first and last amount elements in logical order
+    SUMMARY     ///< only statistics of the list
+};
+
+/// gets old and new slots of amount moved elements at once
+typedef void (*list_remap_f)(const size_t* old_pos, const size_t* new_pos, const size_t amount, void* context);
+
+/// where compaction reports new slots of elements, both ways are optional,
+/// reported slots are valid only after compaction returns
+struct ListRemap
+{
+    size_t*      old_to_new;    ///< list->used slots as before compaction, slots without element get 0
+    list_remap_f callback;      ///< gets only elements, which changed their slots, it must not use the list
+    void*        context;
+};
+
+/// dumped object of part dumps, amount is limited by MAX_DUMPED_SLOTS
+struct ListDumpRequest
+{
+    const void*  list;
+    ListDumpMode mode;
+
+    size_t pos;
+    size_t amount;
+};
+
+/// copy of dumped slot, graph worker draws it instead of the list
+template <typename T>
+struct ListGraphSlot
+{
+    size_t    pos;
+    long long next;
+    long long prev;
+    bool      empty;
+    T         data;     ///< constructed only in busy slots
+};
+
+/// copy of dumped slots and fields of the list, list can be changed right after dump
+template <typename T>
+struct ListGraphSnapshot
+{
+    long long head;
+    long long tail;
+    long long free;
+
+    size_t size;
+    size_t capacity;
 
-ListErrors ListCtor(list_t* list, ErrorInfo* error, size_t capacity = DEFAULT_LIST_CAPACITY);
-void       ListDtor(list_t* list);
+    ListGraphSlot<T>* slots;
+    size_t            slots_amt;
+};
+
+template <class ListT>
+ListErrors MakeListShorter(ListT* list, const size_t new_capacity, ErrorInfo* error,
+                           const ListRemap* remap = nullptr);
+template <class ListT>
+ListErrors ListLinearize(ListT* list, ErrorInfo* error, const ListRemap* remap = nullptr);
+
+template <class ListT>
+ListErrors ListCtor(ListT* list, ErrorInfo* error, size_t capacity = DEFAULT_LIST_CAPACITY);
+template <class ListT>
+void       ListDtor(ListT* list);
+
+template <class ListT>
+ListErrors GetListElement(const ListT* list, const size_t pos, typename ListT::data_t* destination,
+                          ErrorInfo* error);
+template <class ListT>
+ListErrors GetListElementByIndex(const ListT* list, const size_t index, typename ListT::data_t* destination,
+                                 ErrorInfo* error);
+template <class ListT>
+size_t     GetListPosByIndex(const ListT* list, const size_t index);
+/// pos must be slot of element
+template <class ListT>
+size_t     GetListIndexByPos(const ListT* list, const size_t pos);
+
+// rank index makes both functions above O(log n) on not linearized list, inserts and removes
+// become O(log n) too, index is not changed by concurrent slots, so it can not be attached while they are started
+
+template <class ListT>
+ListErrors ListAttachRankIndex(ListT* list, ErrorInfo* error);
+template <class ListT>
+void       ListDetachRankIndex(ListT* list);
+template <class ListT>
+typename ListT::index_t GetListHead(const ListT* list);
+template <class ListT>
+typename ListT::index_t GetListTail(const ListT* list);
+
+/// largest capacity, which slots can be addressed by links of the list
+template <class ListT>
+constexpr size_t GetMaxListCapacity()
+{
+    size_t max_capacity = (size_t) std::numeric_limits<typename ListT::index_t>::max() + 1;
 
-ListErrors GetListElement(const list_t* list, const size_t pos, int* destination, ErrorInfo* error);
-int        GetListHead(const list_t* list);
-int        GetListTail(const list_t* list);
+    if (ListT::LAYOUT == ListLayout::CHUNKED && max_capacity > MAX_LIST_CHUNKS * LIST_CHUNK_ELEMS)
+        return MAX_LIST_CHUNKS * LIST_CHUNK_ELEMS;
 
-ListErrors ListInsertAfterElem(list_t* list, const size_t pos, const int value,
+    return max_capacity;
+}
+
+template <class ListT>
+ListErrors ListInsertAfterElem(ListT* list, const size_t pos, typename ListT::data_t value,
                                size_t* inserted_pos, ErrorInfo* error);
-ListErrors ListInsertBeforeElem(list_t* list, const size_t pos, const int value,
+template <class ListT>
+ListErrors ListInsertBeforeElem(ListT* list, const size_t pos, typename ListT::data_t value,
                                 size_t* inserted_pos, ErrorInfo* error);
-ListErrors ListRemoveElem(list_t* list, const size_t pos, ErrorInfo* error);
+template <class ListT>
+ListErrors ListRemoveElem(ListT* list, const size_t pos, ErrorInfo* error);
+
+// handles of elements are checked in O(1): removal of element and compaction of list make them stale,
+// growth of list does not change them, handles can not be taken while concurrent slots are started
+
+template <class ListT>
+ListErrors GetListHandle(ListT* list, const size_t pos, list_handle_t* handle, ErrorInfo* error);
+template <class ListT>
+size_t     GetListHandlePos(const ListT* list, const list_handle_t handle);
+template <class ListT>
+ListErrors GetListElementByHandle(const ListT* list, const list_handle_t handle,
+                                  typename ListT::data_t* destination, ErrorInfo* error);
+template <class ListT>
+ListErrors ListRemoveByHandle(ListT* list, const list_handle_t handle, ErrorInfo* error);
+
+// search of value goes over slots in physical order, not over links, so found element is any element with value,
+// int elements are compared by vectorized kernels
+
+template <class ListT>
+size_t     ListFindValue(const ListT* list, const typename ListT::data_t& value);
+template <class ListT>
+bool       ListContains(const ListT* list, const typename ListT::data_t& value);
+template <class ListT>
+size_t     ListCountValue(const ListT* list, const typename ListT::data_t& value);
+
+// value index makes search of value O(1), data type needs std::hash and ==,
+// index is not changed by concurrent slots, so it can not be attached while they are started
+
+template <class ListT>
+ListErrors ListAttachValueIndex(ListT* list, ErrorInfo* error);
+template <class ListT>
+void       ListDetachValueIndex(ListT* list);
+template <class ListT>
+ListErrors ListRemoveValue(ListT* list, const typename ListT::data_t& value, ErrorInfo* error);
+
+// aggregates of int list do not depend on order of elements, so slots are read in physical order,
+// with threads > 1 slots are split into ranges, which are read in parallel
+
+template <class ListT>
+ListErrors ListAggregate(const ListT* list, IntAggregates* aggregates, ErrorInfo* error, const size_t threads = 1);
+template <class ListT>
+ListErrors ListCountHistogram(const ListT* list, IntHistogram* histogram, ErrorInfo* error, const size_t threads = 1);
+
+// func is called for every element in physical order of slots, different threads call it for different elements:
+// func(const data_t& value, size_t pos) by for each, func(data_t& value, size_t pos) by transform
+
+template <class ListT, class FuncT>
+ListErrors ListParallelForEach(const ListT* list, FuncT func, ErrorInfo* error, const size_t threads = 1);
+template <class ListT, class FuncT>
+ListErrors ListParallelTransform(ListT* list, FuncT func, ErrorInfo* error, const size_t threads = 1);
+
+// concurrent mode of chunked list: reserve and release are lock-free and can be called by many threads,
+// link and unlink change list itself, so calls of them must be serialized by caller
+
+template <class ListT>
+void       ListStartConcurrentSlots(ListT* list, ListConcurrentSlots* slots);
+template <class ListT>
+void       ListStopConcurrentSlots(ListT* list, ListConcurrentSlots* slots);
+template <class ListT>
+ListErrors ListReserveSlot(ListT* list, ListConcurrentSlots* slots, typename ListT::data_t value,
+                           size_t* reserved_pos, ErrorInfo* error);
+template <class ListT>
+void       ListReleaseSlot(ListT* list, ListConcurrentSlots* slots, const size_t pos);
+template <class ListT>
+void       ListLinkSlotAfter(ListT* list, const size_t pos, const size_t slot);
+template <class ListT>
+void       ListUnlinkSlot(ListT* list, const size_t pos);
+template <class ListT>
 int        ListDump(FILE* fp, const void* list, const char* func, const char* file, const int line);
-ListErrors ListVerify(const list_t* list);
+template <class ListT>
+ListErrors ListVerify(const ListT* list);
+
+template <class ListT>
+int        ListPartDump(FILE* fp, const void* dump_request, const char* func, const char* file, const int line);
+
+template <class ListT>
+inline dump_f GetListDumpFunc(const ListT* /* list */) { return ListDump<ListT>; }
+template <class ListT>
+inline dump_f GetListPartDumpFunc(const ListT* /* list */) { return ListPartDump<ListT>; }
+
+/// prints element data in dumps, width is used only by numbers (like in printf)
+void PrintListValue(FILE* fp, const int value, const int width);
+void PrintListValue(FILE* fp, const long long value, const int width);
+void PrintListValue(FILE* fp, const double value, const int width);
+
+template <typename T>
+void PrintListValue(FILE* fp, const T& value, const int width);
 
 #ifdef DUMP_LIST
 #undef DUMP_LIST
 #endif
-#define DUMP_LIST(list)     do                                                              \
-                            {                                                               \
-                                LogDump(ListDump, (list), __func__, __FILE__, __LINE__);    \
+#define DUMP_LIST(list)     do                                                                          \
+                            {                                                                           \
+                                LogDump(GetListDumpFunc(list), (list), __func__, __FILE__, __LINE__);   \
                             } while(0)
 
+#ifdef DUMP_LIST_PART
+#undef DUMP_LIST_PART
 #endif
+#define DUMP_LIST_PART(list, mode, pos, amount)                                                         \
+                            do                                                                          \
+                            {                                                                           \
+                                ListDumpRequest request_ = {(list), (mode), (pos), (amount)};           \
+                                LogDump(GetListPartDumpFunc(list), &request_,                           \
+                                        __func__, __FILE__, __LINE__);                                  \
+                            } while(0)
 
+#define DUMP_LIST_WINDOW(list, pos, radius) DUMP_LIST_PART(list, ListDumpMode::WINDOW, pos, radius)
+#define DUMP_LIST_ENDS(list, amount)        DUMP_LIST_PART(list, ListDumpMode::ENDS, 0, amount)
+#define DUMP_LIST_SUMMARY(list)             DUMP_LIST_PART(list, ListDumpMode::SUMMARY, 0, 0)
+
+#include "fast_list_impl.h"
+
+#endif
@@ -0,0 +1,3335 @@
+/*! \file
+* \brief Contains fast list template functions, included only by fast_list.h
+*/
+
+#ifndef __FAST_LIST_IMPL_H_
+#define __FAST_LIST_IMPL_H_
+
+#include <assert.h>
+#include <string.h>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <thread>
+#include <system_error>
+#include <functional>
+
+#include "graphs.h"
+#include "list_simd.h"
+
+static const int    CAPACITY_MULTIPLIER  =  2;
+static const size_t LIST_ARRAY_ALIGNMENT = 64;
+
+static const size_t LIST_REMAP_BATCH = 256;
+
+static const size_t LIST_RANGE_SLOTS = 64;  ///< borders of parallel ranges are multiples of it
+
+static const size_t MIN_LIST_INDEX_CAPACITY = 16;
+static const size_t LIST_INDEX_LOAD_DIVISOR = 2;    ///< index grows when it is filled by half
+
+static const int                NULL_RANK_NODE = 0;     ///< slot of fictive element
+static const unsigned long long LIST_RANK_SEED = 0x9e3779b97f4a7c15ull;
+
+static const size_t MAX_LIST_INDEXED_SLOTS = (size_t) INT_MAX + 1;
+
+/// moves of elements, which are collected for remap callback
+struct ListRemapBatch
+{
+    const ListRemap* remap;
+
+    size_t old_pos[LIST_REMAP_BATCH];
+    size_t new_pos[LIST_REMAP_BATCH];
+    size_t amount;
+};
+
+static const unsigned long long LIST_SLOT_MASK  = 0xFFFFFFFFull;
+static const int                LIST_TAG_SHIFT  = 32;
+
+// ================== STORAGE FUNCS ====================
+
+template <class ListT>
+static ListErrors InitListStorage(ListT* list, const size_t capacity, ErrorInfo* error);
+template <class ListT>
+static ListErrors AllocListStorage(ListT* list, const size_t capacity, ErrorInfo* error);
+template <class ListT>
+static void       FreeListStorage(ListT* list);
+template <typename U>
+static U*         AllocAlignedListArray(const size_t amount);
+template <class ListT>
+static bool       AllocListChunks(ListT* list, const size_t old_capacity, const size_t new_capacity);
+template <class ListT>
+static bool       GrowListChunkDirectory(ListT* list, const size_t min_chunks);
+template <class ListT>
+static inline size_t AlignListCapacity(const size_t capacity);
+template <class ListT>
+static constexpr size_t GetMaxListChunks();
+
+template <class ListT>
+static inline void InitListElem(ListT* list, const size_t pos, typename ListT::data_t&& value,
+                                const size_t prev_pos, const size_t next_pos);
+template <class ListT>
+static inline void InitFreeListElem(ListT* list, const size_t pos, const size_t next_free);
+template <class ListT>
+static inline typename ListT::index_t GetFirstUnusedFreeElem(const ListT* list);
+template <class ListT>
+static inline void InitFictiveListElem(ListT* list, const size_t prev_pos, const size_t next_pos);
+template <class ListT>
+static inline void UpdateNeighbourElems(ListT* list, const size_t pos);
+
+// =====================================================
+
+template <class ListT>
+static inline void   AddFreeElemInList(ListT* list, const size_t pos);
+template <class ListT>
+static inline size_t GetFreeElemFromList(ListT* list);
+
+template <class ListT>
+static ListExtras*             GetListExtras(ListT* list, ErrorInfo* error);
+template <class ListT>
+static inline ListValueIndex*  GetListValueIndex(const ListT* list);
+template <class ListT>
+static inline ListRankIndex*   GetListRankIndex(const ListT* list);
+
+template <class ListT>
+static inline ListErrors ReserveListIndexEntry(ListT* list, ErrorInfo* error);
+template <class ListT>
+static ListErrors        ResizeListValueIndex(ListT* list, const size_t capacity, ErrorInfo* error);
+template <class ListT>
+static inline void       AddListIndexEntry(ListT* list, const size_t pos);
+template <class ListT>
+static inline void       RemoveListIndexEntry(ListT* list, const size_t pos);
+template <class ListT>
+static void              RebuildListValueIndex(ListT* list);
+template <class ListT>
+static size_t            FindInListValueIndex(const ListT* list, const typename ListT::data_t& value, size_t* count);
+static inline void       PutListIndexEntry(ListValueIndex* index, const ListIndexEntry entry);
+template <typename T>
+static inline unsigned long long GetListValueHash(const T& value);
+template <typename T>
+static constexpr bool    IsListValueHashable();
+
+template <class ListT>
+static inline ListErrors ReserveListRankNodes(ListT* list, ErrorInfo* error);
+template <class ListT>
+static ListErrors        GrowListRankNodes(ListT* list, ErrorInfo* error);
+template <class ListT>
+static void              AddListRankNode(ListT* list, const size_t pos);
+template <class ListT>
+static void              RemoveListRankNode(ListT* list, const size_t pos);
+template <class ListT>
+static void              RebuildListRankIndex(ListT* list);
+static inline void       RotateListRankNode(ListRankIndex* index, const int node);
+static inline void       CountListRankNode(ListRankIndex* index, const int node);
+static inline void       AddListRankCounts(ListRankIndex* index, int node, const int delta);
+static inline unsigned   GetListRankPriority(ListRankIndex* index);
+
+template <class ListT>
+static ListErrors  GrowListGenerations(ListT* list, const size_t pos, ErrorInfo* error);
+template <class ListT>
+static inline void BumpListGeneration(ListT* list, const size_t pos);
+template <class ListT>
+static void        BumpListGenerations(ListT* list, const size_t end_pos);
+
+template <class ListT>
+static constexpr bool IsIntList();
+template <class ListT, class ScanF>
+static void           ScanListIntRuns(const ListT* list, const size_t first_pos, const size_t end_pos, ScanF scan);
+
+template <class ListT>
+static void       GetListRange(const ListT* list, const size_t parts, const size_t part,
+                               size_t* first_pos, size_t* end_pos);
+template <class ListT, class RangeF>
+static ListErrors RunOnListRanges(ListT* list, const size_t threads, RangeF range_func, ErrorInfo* error);
+template <class ListT, class FuncT>
+static void       VisitListRange(ListT* list, const size_t first_pos, const size_t end_pos, FuncT& func);
+
+template <class ListT>
+static ListErrors ReserveUnusedSlot(ListT* list, ListConcurrentSlots* slots, size_t* reserved_pos);
+template <class ListT>
+static void       SetFreeListEnd(ListT* list, const size_t old_end, const size_t new_end);
+static inline unsigned long long MakeTaggedSlot(const unsigned long long old_top, const size_t pos);
+
+template <class ListT>
+static inline bool IsEmptyListElem(const ListT* list, const size_t pos);
+
+template <class ListT>
+static void CheckRemovingElement(const ListT* list, const size_t pos, ErrorInfo* error);
+template <class ListT>
+static void CheckGettingElement(const ListT* list, const size_t pos, ErrorInfo* error);
+
+// ================== REALLOC FUNCS ===================
+
+template <class ListT>
+static ListErrors MakeListLonger(ListT* list, ErrorInfo* error);
+
+template <class ListT>
+static void FillShorterList(ListT* old_list, ListT* new_list, ListRemapBatch* batch);
+
+template <class ListT>
+static void        StartListRemap(const ListT* list, const ListRemap* remap, ListRemapBatch* batch);
+static inline void AddListRemap(ListRemapBatch* batch, const size_t old_pos, const size_t new_pos);
+static inline void FlushListRemap(ListRemapBatch* batch);
+
+template <class ListT>
+static ListErrors ReallocListStorage(ListT* list, const size_t new_capacity, ErrorInfo* error);
+
+template <typename T>
+static inline void MoveListData(T* dest, T* src);
+
+template <class ListT>
+static inline void MoveListElem(ListT* list, const size_t from, const size_t to);
+template <class ListT>
+static inline void SwapListElems(ListT* list, const size_t first, const size_t second);
+
+// =====================================================
+
+// ========= TEXT DUMP =======
+
+template <class ListT>
+static void TextListDump(FILE* fp, const ListT* list, const size_t* slots, const size_t slots_amt);
+template <class ListT>
+static void DumpListPart(FILE* fp, const ListT* list, const ListDumpRequest* request);
+
+template <class ListT>
+static inline void PrintListInfo(FILE* fp, const ListT* list);
+template <class ListT>
+static inline void PrintListElements(FILE* fp, const ListT* list, const size_t* slots, const size_t slots_amt);
+template <class ListT>
+static void        PrintListSummary(FILE* fp, const ListT* list);
+template <class ListT>
+static inline void PrintListSizes(FILE* fp, const ListT* list);
+template <class ListT>
+static size_t      SelectDumpedSlots(const ListT* list, const ListDumpRequest* request, size_t* slots);
+static inline size_t GetDumpedSlot(const size_t* slots, const size_t i);
+template <class ListT>
+static inline void ChooseElementHtmlColor(FILE* fp, const ListT* list, const size_t pos);
+template <class ListT>
+static inline long long GetDumpedNext(const ListT* list, const size_t pos);
+template <class ListT>
+static inline long long GetDumpedPrev(const ListT* list, const size_t pos);
+
+// ===========================
+
+// ========= GRAPHS ==========
+
+template <class ListT>
+static void DrawListGraph(const ListT* list, const size_t* slots, const size_t slots_amt);
+template <class ListT>
+static ListGraphSnapshot<typename ListT::data_t>* MakeListGraphSnapshot(const ListT* list, const size_t* slots,
+                                                                        const size_t slots_amt);
+template <typename T>
+static void        DrawListSnapshot(FILE* dotf, void* graph);
+
+template <typename T>
+static inline void DrawListInfo(FILE* dotf, const ListGraphSnapshot<T>* snapshot);
+template <typename T>
+static inline void DrawListElements(FILE* dotf, const ListGraphSnapshot<T>* snapshot);
+template <typename T>
+static inline void CenterListElements(FILE* dotf, const ListGraphSnapshot<T>* snapshot);
+template <typename T>
+static inline void DrawListArrows(FILE* dotf, const ListGraphSnapshot<T>* snapshot);
+template <typename T>
+static inline void ChooseVertexColor(FILE* dotf, const ListGraphSlot<T>* slot);
+template <typename T>
+static inline void MarkImportantElements(FILE* dotf, const ListGraphSnapshot<T>* snapshot, const ListGraphSlot<T>* slot);
+
+// ===========================
+
+template <class ListPtrT>
+static constexpr bool IsListChecked()
+{
+    return std::remove_pointer<ListPtrT>::type::CHECKS != ListChecks::UNCHECKED;
+}
+
+#ifdef CHECK_LIST
+#undef CHECK_LIST
+#endif
+#define CHECK_LIST(list)    do                                                              \
+                            {                                                               \
+                                if constexpr (IsListChecked<decltype(list)>())              \
+                                {                                                           \
+                                    ListErrors list_err_ = ListVerify(list);                \
+                                    if (list_err_ != ListErrors::NONE)                      \
+                                        return list_err_;                                   \
+                                }                                                           \
+                            } while(0)
+
+template <class ListT>
+ListErrors ListCtor(ListT* list, ErrorInfo* error, size_t capacity)
+{
+    assert(list);
+
+    if (capacity > GetMaxListCapacity<ListT>())
+    {
+        error->code = (int) ListErrors::INDEX_OVERFLOW;
+        error->data = "LIST CAPACITY";
+        return ListErrors::INDEX_OVERFLOW;
+    }
+
+    capacity = AlignListCapacity<ListT>(capacity);
+
+    InitListStorage(list, capacity, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    list->capacity   = capacity;
+    list->size       = 0;
+    list->used       = 1;
+    list->free       = GetFirstUnusedFreeElem(list);
+    list->linearized = true;
+
+    list->extras     = nullptr;
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static ListErrors InitListStorage(ListT* list, const size_t capacity, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    AllocListStorage(list, capacity, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    // other elements are filled only when they are taken from free list
+    InitFictiveListElem(list, 0, 0);
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static ListErrors AllocListStorage(ListT* list, const size_t capacity, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    typedef typename ListT::data_t  T;
+    typedef typename ListT::index_t index_t;
+    typedef typename ListT::slot_t  slot_t;
+
+    bool allocated = false;
+
+    if constexpr (ListT::LAYOUT == ListLayout::AOS)
+    {
+        list->elems = (slot_t*) calloc(capacity, sizeof(slot_t));
+
+        allocated   = (list->elems != nullptr);
+    }
+    else if constexpr (ListT::LAYOUT == ListLayout::SOA)
+    {
+        list->data  = AllocAlignedListArray<T>(capacity);
+        list->next  = AllocAlignedListArray<index_t>(capacity);
+        list->prev  = AllocAlignedListArray<index_t>(capacity);
+
+        allocated   = (list->data != nullptr && list->next != nullptr && list->prev != nullptr);
+    }
+    else
+    {
+        list->chunks          = nullptr;
+        list->chunks_capacity = 0;
+
+        allocated = AllocListChunks(list, 0, capacity);
+    }
+
+    if (!allocated)
+    {
+        FreeListStorage(list);
+
+        error->code = (int) ListErrors::ALLOCATE_MEMORY;
+        error->data = "ELEMENTS ARRAY";
+        return ListErrors::ALLOCATE_MEMORY;
+    }
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <typename U>
+static U* AllocAlignedListArray(const size_t amount)
+{
+    size_t bytes = amount * sizeof(U);
+    //                          v------ aligned_alloc wants size to be multiple of alignment
+    bytes = (bytes + LIST_ARRAY_ALIGNMENT - 1) / LIST_ARRAY_ALIGNMENT * LIST_ARRAY_ALIGNMENT;
+
+    return (U*) aligned_alloc(LIST_ARRAY_ALIGNMENT, bytes);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static bool AllocListChunks(ListT* list, const size_t old_capacity, const size_t new_capacity)
+{
+    assert(list);
+
+    typedef typename ListT::slot_t slot_t;
+
+    if (new_capacity > GetMaxListCapacity<ListT>())
+        return false;
+
+    if ((new_capacity >> LIST_CHUNK_SHIFT) > list->chunks_capacity &&
+        !GrowListChunkDirectory(list, new_capacity >> LIST_CHUNK_SHIFT))
+        return false;
+
+    for (size_t chunk = old_capacity >> LIST_CHUNK_SHIFT; chunk < new_capacity >> LIST_CHUNK_SHIFT; chunk++)
+    {
+        //                         v------ not calloc, slots are filled only when they are taken
+        list->chunks[chunk] = (slot_t*) malloc(LIST_CHUNK_ELEMS * sizeof(slot_t));
+
+        if (list->chunks[chunk] == nullptr)
+            return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static bool GrowListChunkDirectory(ListT* list, const size_t min_chunks)
+{
+    assert(list);
+
+    typedef typename ListT::slot_t slot_t;
+
+    size_t dir_capacity = list->chunks_capacity * CAPACITY_MULTIPLIER;
+
+    if (dir_capacity < min_chunks)
+        dir_capacity = min_chunks;
+    if (dir_capacity > GetMaxListChunks<ListT>())
+        dir_capacity = GetMaxListChunks<ListT>();
+
+    // entry before the first chunk keeps previous directory, all of them are freed with the storage
+    slot_t** dir = (slot_t**) calloc(dir_capacity + 1, sizeof(slot_t*));
+    if (dir == nullptr)
+        return false;
+
+    if (list->chunks != nullptr)
+    {
+        memcpy(dir + 1, list->chunks, list->chunks_capacity * sizeof(slot_t*));
+        dir[0] = (slot_t*) (void*) (list->chunks - 1);
+    }
+
+    // concurrent threads read directory without lock, they see either old or new one
+    __atomic_store_n(&list->chunks, dir + 1, __ATOMIC_RELEASE);
+    list->chunks_capacity = dir_capacity;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline size_t AlignListCapacity(const size_t capacity)
+{
+    if (ListT::LAYOUT != ListLayout::CHUNKED)
+        return capacity;
+
+    return (capacity + LIST_CHUNK_MASK) & ~LIST_CHUNK_MASK;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static constexpr size_t GetMaxListChunks()
+{
+    return GetMaxListCapacity<ListT>() >> LIST_CHUNK_SHIFT;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void FreeListStorage(ListT* list)
+{
+    assert(list);
+
+    if constexpr (ListT::LAYOUT == ListLayout::AOS)
+    {
+        free(list->elems);
+        list->elems = nullptr;
+    }
+    else if constexpr (ListT::LAYOUT == ListLayout::SOA)
+    {
+        free(list->data);
+        free(list->next);
+        free(list->prev);
+
+        list->data = nullptr;
+        list->next = nullptr;
+        list->prev = nullptr;
+    }
+    else
+    {
+        if (list->chunks == nullptr)
+            return;
+
+        for (size_t chunk = 0; chunk < list->chunks_capacity && list->chunks[chunk] != nullptr; chunk++)
+            free(list->chunks[chunk]);
+
+        for (typename ListT::slot_t** dir = list->chunks - 1; dir != nullptr; )
+        {
+            typename ListT::slot_t** prev_dir = (typename ListT::slot_t**) (void*) dir[0];
+
+            free(dir);
+            dir = prev_dir;
+        }
+
+        list->chunks          = nullptr;
+        list->chunks_capacity = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+typename ListT::index_t GetListHead(const ListT* list)
+{
+    return ListNext(list, FICTIVE_ELEM_POS);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+typename ListT::index_t GetListTail(const ListT* list)
+{
+    return ListPrev(list, FICTIVE_ELEM_POS);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors GetListElement(const ListT* list, const size_t pos, typename ListT::data_t* destination,
+                          ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+    assert(destination);
+
+    if constexpr (IsListChecked<ListT*>())
+    {
+        CheckGettingElement(list, pos, error);
+        RETURN_IF_LISTERROR((ListErrors) error->code);
+    }
+
+    *destination = ListData(list, pos);
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors GetListElementByIndex(const ListT* list, const size_t index, typename ListT::data_t* destination,
+                                 ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+    assert(destination);
+
+    if (IsListChecked<ListT*>() && index >= list->size)
+    {
+        error->code = (int) ListErrors::INVALID_INDEX;
+        error->data = list;
+        return ListErrors::INVALID_INDEX;
+    }
+
+    *destination = ListData(list, GetListPosByIndex(list, index));
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+size_t GetListPosByIndex(const ListT* list, const size_t index)
+{
+    assert(list);
+
+    if (index >= list->size)
+        return FICTIVE_ELEM_POS;
+
+    if (list->linearized)
+        return index + 1;
+
+    const ListRankIndex* rank_index = GetListRankIndex(list);
+
+    if (rank_index)
+    {
+        const ListRankNode* nodes = rank_index->nodes;
+
+        int    node = rank_index->root;
+        size_t rank = index;
+
+        // left subtree holds elements before node
+        while ((size_t) nodes[nodes[node].left].count != rank)
+        {
+            size_t left_count = (size_t) nodes[nodes[node].left].count;
+
+            if (rank < left_count)
+            {
+                node = nodes[node].left;
+            }
+            else
+            {
+                rank -= left_count + 1;
+                node  = nodes[node].right;
+            }
+        }
+
+        return (size_t) node;
+    }
+
+    size_t pos = FICTIVE_ELEM_POS;
+
+    //             v------ walking from the nearest end
+    if (index < list->size / 2)
+    {
+        for (size_t i = 0; i <= index; i++)
+            pos = ListNext(list, pos);
+    }
+    else
+    {
+        for (size_t i = list->size; i > index; i--)
+            pos = ListPrev(list, pos);
+    }
+
+    return pos;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+size_t GetListIndexByPos(const ListT* list, const size_t pos)
+{
+    assert(list);
+    assert(pos != FICTIVE_ELEM_POS);
+
+    if (list->linearized)
+        return pos - 1;
+
+    const ListRankIndex* rank_index = GetListRankIndex(list);
+
+    if (rank_index)
+    {
+        const ListRankNode* nodes = rank_index->nodes;
+
+        int    node  = (int) pos;
+        size_t index = (size_t) nodes[nodes[node].left].count;
+
+        // if node is in right subtree of ancestor, ancestor and its left subtree are before node
+        for (int parent = nodes[node].parent; parent != NULL_RANK_NODE; node = parent, parent = nodes[node].parent)
+        {
+            if (nodes[parent].right == node)
+                index += (size_t) nodes[nodes[parent].left].count + 1;
+        }
+
+        return index;
+    }
+
+    size_t index = 0;
+
+    for (size_t curr_pos = (size_t) ListPrev(list, pos); curr_pos != FICTIVE_ELEM_POS; curr_pos = (size_t) ListPrev(list, curr_pos))
+        index++;
+
+    return index;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors ListAttachRankIndex(ListT* list, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    if (GetListRankIndex(list))
+        return ListErrors::NONE;
+
+    GrowListRankNodes(list, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    list->extras->rank_index.seed = LIST_RANK_SEED;
+
+    RebuildListRankIndex(list);
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+void ListDetachRankIndex(ListT* list)
+{
+    assert(list);
+
+    if (list->extras == nullptr)
+        return;
+
+    free(list->extras->rank_index.nodes);
+    list->extras->rank_index = {};
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline ListErrors ReserveListRankNodes(ListT* list, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    const ListRankIndex* index = GetListRankIndex(list);
+
+    // new slots are taken only after growth of list, so nodes are reserved for all of them
+    if (index && index->capacity < list->capacity)
+        return GrowListRankNodes(list, error);
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static ListErrors GrowListRankNodes(ListT* list, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    // nodes link each other by int slots, like links of default list
+    if (list->capacity > MAX_LIST_INDEXED_SLOTS)
+    {
+        error->code = (int) ListErrors::INDEX_OVERFLOW;
+        error->data = "RANK INDEX";
+        return ListErrors::INDEX_OVERFLOW;
+    }
+
+    ListExtras* extras = GetListExtras(list, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    ListRankNode* nodes = (ListRankNode*) realloc(extras->rank_index.nodes, list->capacity * sizeof(ListRankNode));
+    if (nodes == nullptr)
+    {
+        error->code = (int) ListErrors::ALLOCATE_MEMORY;
+        error->data = "RANK INDEX";
+        return ListErrors::ALLOCATE_MEMORY;
+    }
+
+    // null node has no subtree, it is never changed
+    nodes[NULL_RANK_NODE] = {};
+
+    extras->rank_index.nodes    = nodes;
+    extras->rank_index.capacity = list->capacity;
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void AddListRankNode(ListT* list, const size_t pos)
+{
+    assert(list);
+
+    ListRankIndex* index = GetListRankIndex(list);
+
+    if (index == nullptr)
+        return;
+
+    ListRankNode* nodes = index->nodes;
+
+    int node = (int) pos;
+    int prev = (int) ListPrev(list, pos);
+    int next = (int) ListNext(list, pos);
+
+    nodes[node] = {0, 0, 0, 1, GetListRankPriority(index)};
+
+    // new node becomes leaf right after previous element or right before next element in in-order
+    if (prev != NULL_RANK_NODE && nodes[prev].right == NULL_RANK_NODE)
+    {
+        nodes[prev].right  = node;
+        nodes[node].parent = prev;
+    }
+    else if (prev != NULL_RANK_NODE)
+    {
+        int parent = nodes[prev].right;
+        while (nodes[parent].left != NULL_RANK_NODE)
+            parent = nodes[parent].left;
+
+        nodes[parent].left = node;
+        nodes[node].parent = parent;
+    }
+    else if (next != NULL_RANK_NODE && nodes[next].left == NULL_RANK_NODE)
+    {
+        nodes[next].left   = node;
+        nodes[node].parent = next;
+    }
+    else if (next != NULL_RANK_NODE)
+    {
+        int parent = nodes[next].left;
+        while (nodes[parent].right != NULL_RANK_NODE)
+            parent = nodes[parent].right;
+
+        nodes[parent].right = node;
+        nodes[node].parent  = parent;
+    }
+    else
+    {
+        index->root = node;
+    }
+
+    AddListRankCounts(index, nodes[node].parent, 1);
+
+    while (nodes[node].parent != NULL_RANK_NODE && nodes[nodes[node].parent].priority < nodes[node].priority)
+        RotateListRankNode(index, node);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void RemoveListRankNode(ListT* list, const size_t pos)
+{
+    assert(list);
+
+    ListRankIndex* index = GetListRankIndex(list);
+
+    if (index == nullptr)
+        return;
+
+    ListRankNode* nodes = index->nodes;
+
+    int node = (int) pos;
+
+    // node goes down to leaf, its child with higher priority takes its place
+    while (nodes[node].left != NULL_RANK_NODE || nodes[node].right != NULL_RANK_NODE)
+    {
+        int left  = nodes[node].left;
+        int right = nodes[node].right;
+
+        if (right == NULL_RANK_NODE || (left != NULL_RANK_NODE && nodes[left].priority > nodes[right].priority))
+            RotateListRankNode(index, left);
+        else
+            RotateListRankNode(index, right);
+    }
+
+    int parent = nodes[node].parent;
+
+    if (parent == NULL_RANK_NODE)
+        index->root = NULL_RANK_NODE;
+    else if (nodes[parent].left == node)
+        nodes[parent].left = NULL_RANK_NODE;
+    else
+        nodes[parent].right = NULL_RANK_NODE;
+
+    AddListRankCounts(index, parent, -1);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void RebuildListRankIndex(ListT* list)
+{
+    assert(list);
+
+    ListRankIndex* index = GetListRankIndex(list);
+
+    if (index == nullptr)
+        return;
+
+    ListRankNode* nodes = index->nodes;
+
+    // cartesian tree of elements in logical order: right spine of tree is stack of nodes,
+    // node leaves it when node with higher priority comes, its subtree is complete then
+    int last = NULL_RANK_NODE;
+    index->root = NULL_RANK_NODE;
+
+    for (int node = (int) GetListHead(list); node != NULL_RANK_NODE; node = (int) ListNext(list, (size_t) node))
+    {
+        nodes[node] = {0, 0, 0, 1, GetListRankPriority(index)};
+
+        int child = NULL_RANK_NODE;
+
+        while (last != NULL_RANK_NODE && nodes[last].priority < nodes[node].priority)
+        {
+            CountListRankNode(index, last);
+
+            child = last;
+            last  = nodes[last].parent;
+        }
+
+        nodes[node].left = child;
+        if (child != NULL_RANK_NODE)
+            nodes[child].parent = node;
+
+        nodes[node].parent = last;
+        if (last != NULL_RANK_NODE)
+            nodes[last].right = node;
+        else
+            index->root = node;
+
+        last = node;
+    }
+
+    for (; last != NULL_RANK_NODE; last = nodes[last].parent)
+        CountListRankNode(index, last);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static inline void RotateListRankNode(ListRankIndex* index, const int node)
+{
+    assert(index);
+
+    ListRankNode* nodes  = index->nodes;
+    int           parent = nodes[node].parent;
+    int           grand  = nodes[parent].parent;
+
+    // node takes place of its parent, inner subtree of node goes to parent
+    if (nodes[parent].left == node)
+    {
+        nodes[parent].left = nodes[node].right;
+        if (nodes[node].right != NULL_RANK_NODE)
+            nodes[nodes[node].right].parent = parent;
+
+        nodes[node].right = parent;
+    }
+    else
+    {
+        nodes[parent].right = nodes[node].left;
+        if (nodes[node].left != NULL_RANK_NODE)
+            nodes[nodes[node].left].parent = parent;
+
+        nodes[node].left = parent;
+    }
+
+    nodes[parent].parent = node;
+    nodes[node].parent   = grand;
+
+    if (grand == NULL_RANK_NODE)
+        index->root = node;
+    else if (nodes[grand].left == parent)
+        nodes[grand].left = node;
+    else
+        nodes[grand].right = node;
+
+    CountListRankNode(index, parent);
+    CountListRankNode(index, node);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static inline void CountListRankNode(ListRankIndex* index, const int node)
+{
+    assert(index);
+
+    ListRankNode* nodes = index->nodes;
+
+    nodes[node].count = nodes[nodes[node].left].count + nodes[nodes[node].right].count + 1;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static inline void AddListRankCounts(ListRankIndex* index, int node, const int delta)
+{
+    assert(index);
+
+    for (; node != NULL_RANK_NODE; node = index->nodes[node].parent)
+        index->nodes[node].count += delta;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static inline unsigned GetListRankPriority(ListRankIndex* index)
+{
+    assert(index);
+
+    // xorshift64, priorities only have to be independent of order of inserts
+    index->seed ^= index->seed << 13;
+    index->seed ^= index->seed >> 7;
+    index->seed ^= index->seed << 17;
+
+    return (unsigned) (index->seed >> 32);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline bool IsEmptyListElem(const ListT* list, const size_t pos)
+{
+    assert(list);
+
+    return pos == FICTIVE_ELEM_POS || pos >= list->used || ListPrev(list, pos) == -1;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void CheckGettingElement(const ListT* list, const size_t pos, ErrorInfo* error)
+{
+    if (IsEmptyListElem(list, pos))
+    {
+        error->code = (int) ListErrors::EMPTY_ELEMENT;
+        error->data = list;
+        return;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+void ListDtor(ListT* list)
+{
+    assert(list);
+
+    typedef typename ListT::data_t T;
+
+    if constexpr (!std::is_trivially_destructible<T>::value)
+    {
+        for (size_t pos = GetListHead(list); pos != FICTIVE_ELEM_POS; pos = ListNext(list, pos))
+            ListData(list, pos).~T();
+    }
+
+    FreeListStorage(list);
+
+    if (list->extras != nullptr)
+    {
+        ListDetachValueIndex(list);
+        ListDetachRankIndex(list);
+
+        free(list->extras->generations);
+        free(list->extras);
+        list->extras = nullptr;
+    }
+
+    // poison is the lowest value, which is not ever met as encoded free index
+    list->free     = (typename ListT::index_t) (std::numeric_limits<typename ListT::index_t>::min() + 1);
+
+    list->capacity = 0;
+    list->size     = 0;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors ListVerify(const ListT* list)
+{
+    assert(list);
+
+    typedef typename ListT::data_t T;
+
+    if (list->size > list->capacity)                  return ListErrors::INVALID_SIZE;
+    if (list->used > list->capacity)                  return ListErrors::INVALID_SIZE;
+    if (ListPrev(list, FICTIVE_ELEM_POS) == -1)       return ListErrors::DAMAGED_FICTIVE;
+
+    if constexpr (ListPoison<T>::ENABLED)
+    {
+        if (ListData(list, FICTIVE_ELEM_POS) != ListPoison<T>::Value())
+                                                      return ListErrors::DAMAGED_FICTIVE;
+    }
+
+    if constexpr (ListT::CHECKS == ListChecks::PARANOID)
+    {
+        // every element must be reached from fictive one and point back to its previous
+        size_t pos = FICTIVE_ELEM_POS;
+
+        for (size_t i = 0; i <= list->size; i++)
+        {
+            size_t next_pos = (size_t) ListNext(list, pos);
+
+            if (next_pos >= list->used || (size_t) ListPrev(list, next_pos) != pos)
+                                                      return ListErrors::DAMAGED_LINKS;
+            pos = next_pos;
+        }
+
+        if (pos != FICTIVE_ELEM_POS)                  return ListErrors::DAMAGED_LINKS;
+    }
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors ListInsertAfterElem(ListT* list, const size_t pos, typename ListT::data_t value,
+                                             size_t* inserted_pos, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    CHECK_LIST(list);
+
+    ReserveListIndexEntry(list, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    if (list->free == FICTIVE_ELEM_POS)
+    {
+        MakeListLonger(list, error);
+        RETURN_IF_LISTERROR((ListErrors) error->code);
+    }
+
+    ReserveListRankNodes(list, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    size_t free_pos = GetFreeElemFromList(list);
+    *inserted_pos   = free_pos;
+
+    // only appends into the next slot keep physical order
+    list->linearized = list->linearized && pos == (size_t) GetListTail(list) && free_pos == list->size + 1;
+
+    InitListElem(list, free_pos, std::move(value), pos, (size_t) ListNext(list, pos));
+    UpdateNeighbourElems(list, free_pos);
+
+    AddListIndexEntry(list, free_pos);
+    AddListRankNode(list, free_pos);
+
+    list->size++;
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors ListInsertBeforeElem(ListT* list, const size_t pos, typename ListT::data_t value,
+                                              size_t* inserted_pos, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    CHECK_LIST(list);
+
+    ReserveListIndexEntry(list, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    if (list->free == FICTIVE_ELEM_POS)
+    {
+        MakeListLonger(list, error);
+        RETURN_IF_LISTERROR((ListErrors) error->code);
+    }
+
+    ReserveListRankNodes(list, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    size_t free_pos = GetFreeElemFromList(list);
+    *inserted_pos   = free_pos;
+
+    // only appends into the next slot keep physical order
+    list->linearized = list->linearized && pos == FICTIVE_ELEM_POS && free_pos == list->size + 1;
+
+    InitListElem(list, free_pos, std::move(value), (size_t) ListPrev(list, pos), pos);
+    UpdateNeighbourElems(list, free_pos);
+
+    AddListIndexEntry(list, free_pos);
+    AddListRankNode(list, free_pos);
+
+    list->size++;
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static ListErrors MakeListLonger(ListT* list, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    //                                        chunked list grows by one chunk, nothing is copied ------v
+    size_t new_capacity = (ListT::LAYOUT == ListLayout::CHUNKED) ? list->capacity + LIST_CHUNK_ELEMS :
+                                                                    list->capacity * CAPACITY_MULTIPLIER;
+    size_t max_capacity = GetMaxListCapacity<ListT>();
+
+    // the last growth takes only slots, which links can still address
+    if (list->capacity >= max_capacity)
+    {
+        error->code = (int) ListErrors::INDEX_OVERFLOW;
+        error->data = "LIST CAPACITY";
+        return ListErrors::INDEX_OVERFLOW;
+    }
+
+    if (new_capacity > max_capacity)
+        new_capacity = max_capacity;
+
+    ReallocListStorage(list, new_capacity, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    list->capacity = new_capacity;
+    list->free     = GetFirstUnusedFreeElem(list);
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static ListErrors ReallocListStorage(ListT* list, const size_t new_capacity, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    typedef typename ListT::data_t T;
+    typedef typename ListT::slot_t slot_t;
+
+    if constexpr (ListT::LAYOUT == ListLayout::AOS && std::is_trivially_copyable<T>::value)
+    {
+        slot_t* temp_elems = (slot_t*) realloc(list->elems, new_capacity * sizeof(slot_t));
+        if (temp_elems == nullptr)
+        {
+            error->code = (int) ListErrors::ALLOCATE_MEMORY;
+            error->data = "ELEMENTS ARRAY";
+            return ListErrors::ALLOCATE_MEMORY;
+        }
+
+        list->elems = temp_elems;
+    }
+    else if constexpr (ListT::LAYOUT == ListLayout::CHUNKED)
+    {
+        if (!AllocListChunks(list, list->capacity, new_capacity))
+        {
+            error->code = (int) ListErrors::ALLOCATE_MEMORY;
+            error->data = "ELEMENTS CHUNK";
+            return ListErrors::ALLOCATE_MEMORY;
+        }
+    }
+    else
+    {
+        // realloc can not keep alignment and can not move objects, so elements are moved by hand
+        ListT new_list = {};
+
+        AllocListStorage(&new_list, new_capacity, error);
+        RETURN_IF_LISTERROR((ListErrors) error->code);
+
+        for (size_t i = 0; i < list->used; i++)
+        {
+            ListNext(&new_list, i) = ListNext(list, i);
+            ListPrev(&new_list, i) = ListPrev(list, i);
+        }
+
+        if constexpr (std::is_trivially_copyable<T>::value)
+        {
+            memcpy(&ListData(&new_list, 0), &ListData(list, 0), list->used * sizeof(T));
+        }
+        else
+        {
+            for (size_t i = 1; i < list->used; i++)
+            {
+                if (!IsEmptyListElem(list, i))
+                    MoveListData(&ListData(&new_list, i), &ListData(list, i));
+            }
+        }
+
+        FreeListStorage(list);
+
+        static_cast<typename ListT::storage_t&>(*list) = new_list;
+    }
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <typename T>
+static inline void MoveListData(T* dest, T* src)
+{
+    assert(dest);
+    assert(src);
+
+    new (dest) T(std::move(*src));
+    src->~T();
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors MakeListShorter(ListT* list, const size_t new_capacity, ErrorInfo* error, const ListRemap* remap)
+{
+    assert(list);
+    assert(error);
+
+    if (list->size > new_capacity)
+    {
+        error->code = (int) ListErrors::INVALID_SIZE;
+        return ListErrors::INVALID_SIZE;
+    }
+
+    size_t capacity = AlignListCapacity<ListT>(new_capacity);
+    ListT  new_list = {};
+
+    InitListStorage(&new_list, capacity, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    ListRemapBatch batch = {};
+    StartListRemap(list, remap, &batch);
+
+    FillShorterList(list, &new_list, &batch);
+
+    FlushListRemap(&batch);
+
+    FreeListStorage(list);
+    static_cast<typename ListT::storage_t&>(*list) = new_list;
+
+    BumpListGenerations(list, list->used);
+
+    list->capacity      = capacity;
+    list->used          = list->size + 1;
+    list->free          = GetFirstUnusedFreeElem(list);
+    list->linearized    = true;
+
+    RebuildListValueIndex(list);
+    RebuildListRankIndex(list);
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void FillShorterList(ListT* old_list, ListT* new_list, ListRemapBatch* batch)
+{
+    assert(old_list);
+    assert(new_list);
+
+    typedef typename ListT::data_t T;
+
+    size_t curr_pos = (size_t) GetListHead(old_list);
+    size_t size     = old_list->size;
+
+    InitFictiveListElem(new_list, size, (size == 0) ? FICTIVE_ELEM_POS : 1);
+    UpdateNeighbourElems(new_list, FICTIVE_ELEM_POS);
+
+    for (size_t i = 1; i <= size; i++)
+    {
+        size_t next_pos = (i == size) ? FICTIVE_ELEM_POS : i + 1;
+
+        InitListElem(new_list, i, std::move(ListData(old_list, curr_pos)), i - 1, next_pos);
+        UpdateNeighbourElems(new_list, i);
+
+        ListData(old_list, curr_pos).~T();
+
+        AddListRemap(batch, curr_pos, i);
+
+        curr_pos = (size_t) ListNext(old_list, curr_pos);
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors ListLinearize(ListT* list, ErrorInfo* error, const ListRemap* remap)
+{
+    assert(list);
+    assert(error);
+
+    CHECK_LIST(list);
+
+    size_t size     = list->size;
+    size_t curr_pos = GetListHead(list);
+
+    // i-th element goes to slot i, so new slots are known before moves
+    if (remap)
+    {
+        ListRemapBatch batch = {};
+        StartListRemap(list, remap, &batch);
+
+        for (size_t i = 1; i <= size; i++, curr_pos = ListNext(list, curr_pos))
+            AddListRemap(&batch, curr_pos, i);
+
+        FlushListRemap(&batch);
+
+        curr_pos = GetListHead(list);
+    }
+
+    // slots 1..i-1 already hold first elements, so i-th element is never before slot i
+    for (size_t i = 1; i <= size; i++)
+    {
+        if (curr_pos != i)
+        {
+            if (IsEmptyListElem(list, i))
+                MoveListElem(list, curr_pos, i);
+            else
+                SwapListElems(list, curr_pos, i);
+        }
+
+        curr_pos = ListNext(list, i);
+    }
+
+    BumpListGenerations(list, list->used);
+
+    // free list was broken by moves, all slots after the last element become unused again
+    list->used       = size + 1;
+    list->free       = GetFirstUnusedFreeElem(list);
+    list->linearized = true;
+
+    RebuildListValueIndex(list);
+    RebuildListRankIndex(list);
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void StartListRemap(const ListT* list, const ListRemap* remap, ListRemapBatch* batch)
+{
+    assert(list);
+    assert(batch);
+
+    batch->remap  = remap;
+    batch->amount = 0;
+
+    if (remap && remap->old_to_new)
+    {
+        for (size_t pos = 0; pos < list->used; pos++)
+            remap->old_to_new[pos] = FICTIVE_ELEM_POS;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static inline void AddListRemap(ListRemapBatch* batch, const size_t old_pos, const size_t new_pos)
+{
+    assert(batch);
+
+    if (batch->remap == nullptr)
+        return;
+
+    if (batch->remap->old_to_new)
+        batch->remap->old_to_new[old_pos] = new_pos;
+
+    if (batch->remap->callback == nullptr || old_pos == new_pos)
+        return;
+
+    batch->old_pos[batch->amount] = old_pos;
+    batch->new_pos[batch->amount] = new_pos;
+
+    if (++batch->amount == LIST_REMAP_BATCH)
+        FlushListRemap(batch);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static inline void FlushListRemap(ListRemapBatch* batch)
+{
+    assert(batch);
+
+    if (batch->amount == 0)
+        return;
+
+    batch->remap->callback(batch->old_pos, batch->new_pos, batch->amount, batch->remap->context);
+    batch->amount = 0;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+size_t ListFindValue(const ListT* list, const typename ListT::data_t& value)
+{
+    assert(list);
+
+    size_t found_pos = FICTIVE_ELEM_POS;
+
+    if (GetListValueIndex(list))
+        return FindInListValueIndex(list, value, nullptr);
+
+    // free int slots hold poison, so they never match other values
+    if constexpr (IsIntList<ListT>())
+    {
+        if (value != LIST_POISON)
+        {
+            ScanListIntRuns(list, 1, list->used, [value, &found_pos](const int* data, const size_t first_pos,
+                                                      const size_t amount, const size_t stride)
+            {
+                size_t found = FindIntValue(data, amount, stride, value);
+                if (found == amount)
+                    return false;
+
+                found_pos = first_pos + found;
+                return true;
+            });
+
+            return found_pos;
+        }
+    }
+
+    for (size_t pos = 1; pos < list->used; pos++)
+    {
+        if (ListPrev(list, pos) != -1 && ListData(list, pos) == value)
+            return pos;
+    }
+
+    return found_pos;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+bool ListContains(const ListT* list, const typename ListT::data_t& value)
+{
+    assert(list);
+
+    return ListFindValue(list, value) != FICTIVE_ELEM_POS;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+size_t ListCountValue(const ListT* list, const typename ListT::data_t& value)
+{
+    assert(list);
+
+    size_t count = 0;
+
+    if (GetListValueIndex(list))
+    {
+        FindInListValueIndex(list, value, &count);
+        return count;
+    }
+
+    if constexpr (IsIntList<ListT>())
+    {
+        if (value != LIST_POISON)
+        {
+            ScanListIntRuns(list, 1, list->used, [value, &count](const int* data, const size_t /* first_pos */,
+                                                  const size_t amount, const size_t stride)
+            {
+                count += CountIntValue(data, amount, stride, value);
+                return false;
+            });
+
+            return count;
+        }
+    }
+
+    for (size_t pos = 1; pos < list->used; pos++)
+        count += (ListPrev(list, pos) != -1 && ListData(list, pos) == value);
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors ListAttachValueIndex(ListT* list, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    static_assert(IsListValueHashable<typename ListT::data_t>(), "value index needs std::hash of data");
+
+    if (GetListValueIndex(list))
+        return ListErrors::NONE;
+
+    size_t capacity = MIN_LIST_INDEX_CAPACITY;
+    while (capacity < list->size * LIST_INDEX_LOAD_DIVISOR + 1)
+        capacity *= 2;
+
+    ResizeListValueIndex(list, capacity, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    RebuildListValueIndex(list);
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+void ListDetachValueIndex(ListT* list)
+{
+    assert(list);
+
+    if (list->extras == nullptr)
+        return;
+
+    free(list->extras->value_index.entries);
+    list->extras->value_index = {};
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors ListRemoveValue(ListT* list, const typename ListT::data_t& value, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    // without index value is found by scan of slots
+    size_t pos = ListFindValue(list, value);
+
+    if (pos == FICTIVE_ELEM_POS)
+    {
+        error->code = (int) ListErrors::MISSING_VALUE;
+        error->data = list;
+        return ListErrors::MISSING_VALUE;
+    }
+
+    return ListRemoveElem(list, pos, error);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static ListExtras* GetListExtras(ListT* list, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    if (list->extras != nullptr)
+        return list->extras;
+
+    list->extras = (ListExtras*) calloc(1, sizeof(ListExtras));
+    if (list->extras == nullptr)
+    {
+        error->code = (int) ListErrors::ALLOCATE_MEMORY;
+        error->data = "LIST EXTRAS";
+    }
+
+    return list->extras;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline ListValueIndex* GetListValueIndex(const ListT* list)
+{
+    assert(list);
+
+    if (list->extras == nullptr || list->extras->value_index.entries == nullptr)
+        return nullptr;
+
+    return &list->extras->value_index;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline ListRankIndex* GetListRankIndex(const ListT* list)
+{
+    assert(list);
+
+    if (list->extras == nullptr || list->extras->rank_index.nodes == nullptr)
+        return nullptr;
+
+    return &list->extras->rank_index;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline ListErrors ReserveListIndexEntry(ListT* list, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    const ListValueIndex* index = GetListValueIndex(list);
+
+    // index is grown before element is inserted, so failed growth does not change list
+    if (index && (index->size + 1) * LIST_INDEX_LOAD_DIVISOR > index->capacity)
+        return ResizeListValueIndex(list, index->capacity * 2, error);
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static ListErrors ResizeListValueIndex(ListT* list, const size_t capacity, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    // slots of entries are int, like links of default list
+    if (list->capacity > MAX_LIST_INDEXED_SLOTS)
+    {
+        error->code = (int) ListErrors::INDEX_OVERFLOW;
+        error->data = "VALUE INDEX";
+        return ListErrors::INDEX_OVERFLOW;
+    }
+
+    ListExtras* extras = GetListExtras(list, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    ListValueIndex  old_index = extras->value_index;
+    ListIndexEntry* entries   = (ListIndexEntry*) calloc(capacity, sizeof(ListIndexEntry));
+
+    if (entries == nullptr)
+    {
+        error->code = (int) ListErrors::ALLOCATE_MEMORY;
+        error->data = "VALUE INDEX";
+        return ListErrors::ALLOCATE_MEMORY;
+    }
+
+    extras->value_index = {entries, capacity, 0};
+
+    // stored hash gives new home bucket, so values are not read again
+    for (size_t i = 0; i < old_index.capacity; i++)
+    {
+        if (old_index.entries[i].slot != FICTIVE_ELEM_POS)
+            PutListIndexEntry(&extras->value_index, old_index.entries[i]);
+    }
+
+    free(old_index.entries);
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline void AddListIndexEntry(ListT* list, const size_t pos)
+{
+    assert(list);
+
+    if constexpr (IsListValueHashable<typename ListT::data_t>())
+    {
+        ListValueIndex* index = GetListValueIndex(list);
+
+        if (index == nullptr)
+            return;
+
+        ListIndexEntry entry = {(unsigned) GetListValueHash(ListData(list, pos)), (int) pos};
+
+        PutListIndexEntry(index, entry);
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static inline void PutListIndexEntry(ListValueIndex* index, const ListIndexEntry entry)
+{
+    assert(index);
+
+    size_t mask   = index->capacity - 1;
+    size_t bucket = entry.hash & mask;
+
+    while (index->entries[bucket].slot != FICTIVE_ELEM_POS)
+        bucket = (bucket + 1) & mask;
+
+    index->entries[bucket] = entry;
+    index->size++;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline void RemoveListIndexEntry(ListT* list, const size_t pos)
+{
+    assert(list);
+
+    if constexpr (IsListValueHashable<typename ListT::data_t>())
+    {
+        ListValueIndex* index = GetListValueIndex(list);
+
+        if (index == nullptr)
+            return;
+
+        size_t mask = index->capacity - 1;
+        size_t hole = (size_t) GetListValueHash(ListData(list, pos)) & mask;
+
+        while ((size_t) index->entries[hole].slot != pos)
+            hole = (hole + 1) & mask;
+
+        // entries after hole are shifted back, if their home bucket is not between hole and them
+        for (size_t next = (hole + 1) & mask; index->entries[next].slot != FICTIVE_ELEM_POS; next = (next + 1) & mask)
+        {
+            size_t home = index->entries[next].hash & mask;
+
+            if (((next - home) & mask) >= ((next - hole) & mask))
+            {
+                index->entries[hole] = index->entries[next];
+                hole = next;
+            }
+        }
+
+        index->entries[hole] = {0, (int) FICTIVE_ELEM_POS};
+        index->size--;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void RebuildListValueIndex(ListT* list)
+{
+    assert(list);
+
+    ListValueIndex* index = GetListValueIndex(list);
+
+    if (index == nullptr)
+        return;
+
+    // table is not smaller than size of list, so rebuild can not fail
+    memset(index->entries, 0, index->capacity * sizeof(ListIndexEntry));
+    index->size = 0;
+
+    for (size_t pos = 1; pos < list->used; pos++)
+    {
+        if (!IsEmptyListElem(list, pos))
+            AddListIndexEntry(list, pos);
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static size_t FindInListValueIndex(const ListT* list, const typename ListT::data_t& value, size_t* count)
+{
+    assert(list);
+
+    size_t found_pos = FICTIVE_ELEM_POS;
+
+    if constexpr (IsListValueHashable<typename ListT::data_t>())
+    {
+        const ListValueIndex* index = GetListValueIndex(list);
+
+        unsigned hash   = (unsigned) GetListValueHash(value);
+        size_t   mask   = index->capacity - 1;
+
+        // equal values have equal hashes, so all of them are in one run of busy entries
+        for (size_t bucket = hash & mask; index->entries[bucket].slot != FICTIVE_ELEM_POS; bucket = (bucket + 1) & mask)
+        {
+            const ListIndexEntry* entry = &index->entries[bucket];
+
+            if (entry->hash != hash || !(ListData(list, (size_t) entry->slot) == value))
+                continue;
+
+            found_pos = (size_t) entry->slot;
+
+            if (count == nullptr)
+                return found_pos;
+
+            (*count)++;
+        }
+    }
+
+    return found_pos;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <typename T>
+static inline unsigned long long GetListValueHash(const T& value)
+{
+    unsigned long long hash = std::hash<T>()(value);
+
+    // std::hash of integers returns them as is, so bits are mixed like in murmur3 finalizer
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <typename T>
+static constexpr bool IsListValueHashable()
+{
+    // disabled specializations of std::hash can not be constructed
+    return std::is_default_constructible<std::hash<T>>::value;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static constexpr bool IsIntList()
+{
+    //                                                      v------ AOS_INT_STRIDE needs int links
+    return std::is_same<typename ListT::data_t, int>::value &&
+           (ListT::LAYOUT == ListLayout::SOA || sizeof(typename ListT::slot_t) == AOS_INT_STRIDE * sizeof(int));
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT, class ScanF>
+static void ScanListIntRuns(const ListT* list, const size_t first_pos, const size_t end_pos, ScanF scan)
+{
+    assert(list);
+    assert(first_pos != FICTIVE_ELEM_POS);
+
+    static_assert(IsIntList<ListT>(), "only int lists with packed elements are scanned by runs");
+
+    // slots first_pos..end_pos-1 are given to scan by runs of ints with constant stride, scan returns true to stop
+    if (first_pos >= end_pos)
+        return;
+
+    if constexpr (ListT::LAYOUT == ListLayout::AOS)
+    {
+        scan(&list->elems[first_pos].data, first_pos, end_pos - first_pos, AOS_INT_STRIDE);
+    }
+    else if constexpr (ListT::LAYOUT == ListLayout::SOA)
+    {
+        scan(&list->data[first_pos], first_pos, end_pos - first_pos, SOA_INT_STRIDE);
+    }
+    else
+    {
+        for (size_t run_pos = first_pos; run_pos < end_pos; )
+        {
+            size_t chunk_end = (run_pos & ~LIST_CHUNK_MASK) + LIST_CHUNK_ELEMS;
+            size_t run_end   = (chunk_end < end_pos) ? chunk_end : end_pos;
+
+            if (scan(&ListData(list, run_pos), run_pos, run_end - run_pos, AOS_INT_STRIDE))
+                return;
+
+            run_pos = run_end;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void GetListRange(const ListT* list, const size_t parts, const size_t part,
+                         size_t* first_pos, size_t* end_pos)
+{
+    assert(list);
+    assert(first_pos);
+    assert(end_pos);
+    assert(part < parts);
+
+    // borders are rounded to LIST_RANGE_SLOTS, so neighbour ranges do not write the same cache lines
+    auto border = [list, parts](const size_t i)
+    {
+        size_t pos = (list->used * i / parts + LIST_RANGE_SLOTS - 1) / LIST_RANGE_SLOTS * LIST_RANGE_SLOTS;
+
+        if (pos == FICTIVE_ELEM_POS)
+            return (size_t) 1;
+
+        return (pos < list->used) ? pos : list->used;
+    };
+
+    *first_pos = border(part);
+    *end_pos   = (part == parts - 1) ? list->used : border(part + 1);
+
+    if (*first_pos > *end_pos)
+        *first_pos = *end_pos;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT, class RangeF>
+static ListErrors RunOnListRanges(ListT* list, const size_t threads, RangeF range_func, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    size_t first_pos = 0;
+    size_t end_pos   = 0;
+
+    if (threads <= 1)
+    {
+        GetListRange(list, 1, 0, &first_pos, &end_pos);
+        range_func(first_pos, end_pos, (size_t) 0);
+
+        return ListErrors::NONE;
+    }
+
+    std::thread* workers = new (std::nothrow) std::thread[threads - 1];
+    if (workers == nullptr)
+    {
+        error->code = (int) ListErrors::ALLOCATE_MEMORY;
+        error->data = "THREADS ARRAY";
+        return ListErrors::ALLOCATE_MEMORY;
+    }
+
+    for (size_t part = 1; part < threads; part++)
+    {
+        GetListRange(list, threads, part, &first_pos, &end_pos);
+
+        // range of thread, which can not be started, is handled by caller
+        try
+        {
+            workers[part - 1] = std::thread(range_func, first_pos, end_pos, part);
+        }
+        catch (const std::system_error&)
+        {
+            range_func(first_pos, end_pos, part);
+        }
+    }
+
+    //                                             v------ first range is handled by caller
+    GetListRange(list, threads, 0, &first_pos, &end_pos);
+    range_func(first_pos, end_pos, (size_t) 0);
+
+    for (size_t part = 1; part < threads; part++)
+        if (workers[part - 1].joinable())
+            workers[part - 1].join();
+
+    delete [] workers;
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors ListAggregate(const ListT* list, IntAggregates* aggregates, ErrorInfo* error, const size_t threads)
+{
+    assert(list);
+    assert(aggregates);
+    assert(error);
+
+    static_assert(IsIntList<ListT>(), "aggregates are counted only for int lists");
+
+    CHECK_LIST(list);
+
+    IntAggregates* parts = (IntAggregates*) calloc((threads > 1) ? threads : 1, sizeof(IntAggregates));
+    if (parts == nullptr)
+    {
+        error->code = (int) ListErrors::ALLOCATE_MEMORY;
+        error->data = "AGGREGATES ARRAY";
+        return ListErrors::ALLOCATE_MEMORY;
+    }
+
+    // free slots hold poison, so they are masked out by kernels
+    RunOnListRanges(list, threads, [list, parts](const size_t first_pos, const size_t end_pos, const size_t part)
+    {
+        InitIntAggregates(&parts[part]);
+
+        ScanListIntRuns(list, first_pos, end_pos, [&parts, part](const int* data, const size_t /* first_pos */,
+                                                                 const size_t amount, const size_t stride)
+        {
+            AggregateInts(data, amount, stride, LIST_POISON, &parts[part]);
+            return false;
+        });
+    }, error);
+
+    if (error->code == (int) ListErrors::NONE)
+    {
+        InitIntAggregates(aggregates);
+
+        for (size_t part = 0; part < ((threads > 1) ? threads : 1); part++)
+            MergeIntAggregates(aggregates, &parts[part]);
+    }
+
+    free(parts);
+
+    return (ListErrors) error->code;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors ListCountHistogram(const ListT* list, IntHistogram* histogram, ErrorInfo* error, const size_t threads)
+{
+    assert(list);
+    assert(histogram);
+    assert(histogram->counts);
+    assert(error);
+
+    static_assert(IsIntList<ListT>(), "histogram is counted only for int lists");
+
+    CHECK_LIST(list);
+
+    // every thread except caller counts in its own copy of buckets, caller counts in given histogram
+    size_t  copies = (threads > 1) ? threads - 1 : 0;
+    size_t* counts = nullptr;
+
+    if (copies > 0)
+    {
+        counts = (size_t*) calloc(copies * histogram->buckets, sizeof(size_t));
+        if (counts == nullptr)
+        {
+            error->code = (int) ListErrors::ALLOCATE_MEMORY;
+            error->data = "HISTOGRAM COPIES";
+            return ListErrors::ALLOCATE_MEMORY;
+        }
+    }
+
+    RunOnListRanges(list, threads, [list, histogram, counts](const size_t first_pos, const size_t end_pos,
+                                                             const size_t part)
+    {
+        IntHistogram part_histogram = *histogram;
+
+        if (part > 0)
+            part_histogram.counts = counts + (part - 1) * histogram->buckets;
+
+        ScanListIntRuns(list, first_pos, end_pos, [&part_histogram](const int* data, const size_t /* first_pos */,
+                                                                    const size_t amount, const size_t stride)
+        {
+            CountIntHistogram(data, amount, stride, LIST_POISON, &part_histogram);
+            return false;
+        });
+    }, error);
+
+    for (size_t copy = 0; copy < copies; copy++)
+    {
+        for (size_t bucket = 0; bucket < histogram->buckets; bucket++)
+            histogram->counts[bucket] += counts[copy * histogram->buckets + bucket];
+    }
+
+    free(counts);
+
+    return (ListErrors) error->code;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT, class FuncT>
+ListErrors ListParallelForEach(const ListT* list, FuncT func, ErrorInfo* error, const size_t threads)
+{
+    assert(list);
+    assert(error);
+
+    CHECK_LIST(list);
+
+    return RunOnListRanges(list, threads, [list, &func](const size_t first_pos, const size_t end_pos,
+                                                        const size_t /* part */)
+    {
+        VisitListRange(list, first_pos, end_pos, func);
+    }, error);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT, class FuncT>
+ListErrors ListParallelTransform(ListT* list, FuncT func, ErrorInfo* error, const size_t threads)
+{
+    assert(list);
+    assert(error);
+
+    CHECK_LIST(list);
+
+    // ranges do not intersect, so every element is changed by only one thread
+    RunOnListRanges(list, threads, [list, &func](const size_t first_pos, const size_t end_pos,
+                                                 const size_t /* part */)
+    {
+        VisitListRange(list, first_pos, end_pos, func);
+    }, error);
+
+    RebuildListValueIndex(list);
+
+    return (ListErrors) error->code;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT, class FuncT>
+static void VisitListRange(ListT* list, const size_t first_pos, const size_t end_pos, FuncT& func)
+{
+    assert(list);
+
+    // slots 1..size of linearized list are all busy, so links are not read
+    size_t busy_end = (list->linearized) ? list->size + 1 : first_pos;
+    size_t pos      = first_pos;
+
+    for (; pos < end_pos && pos < busy_end; pos++)
+        func(ListData(list, pos), pos);
+
+    for (; pos < end_pos; pos++)
+    {
+        if (ListPrev(list, pos) != -1)
+            func(ListData(list, pos), pos);
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline void MoveListElem(ListT* list, const size_t from, const size_t to)
+{
+    assert(list);
+
+    MoveListData(&ListData(list, to), &ListData(list, from));
+
+    ListNext(list, to) = ListNext(list, from);
+    ListPrev(list, to) = ListPrev(list, from);
+    UpdateNeighbourElems(list, to);
+
+    InitFreeListElem(list, from, FICTIVE_ELEM_POS);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline void SwapListElems(ListT* list, const size_t first, const size_t second)
+{
+    assert(list);
+
+    typedef typename ListT::index_t index_t;
+
+    index_t first_next  = ListNext(list, first);
+    index_t first_prev  = ListPrev(list, first);
+    index_t second_next = ListNext(list, second);
+    index_t second_prev = ListPrev(list, second);
+
+    // neighbours can be swapped elements themselves
+    auto swap_pos = [first, second](const index_t pos)
+    {
+        if ((size_t) pos == first)  return (index_t) second;
+        if ((size_t) pos == second) return (index_t) first;
+        return pos;
+    };
+
+    std::swap(ListData(list, first), ListData(list, second));
+
+    ListNext(list, second) = swap_pos(first_next);
+    ListPrev(list, second) = swap_pos(first_prev);
+    ListNext(list, first)  = swap_pos(second_next);
+    ListPrev(list, first)  = swap_pos(second_prev);
+
+    UpdateNeighbourElems(list, first);
+    UpdateNeighbourElems(list, second);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline size_t GetFreeElemFromList(ListT* list)
+{
+    assert(list);
+    assert(list->free >= 0);
+
+    size_t free_pos = (size_t) list->free;
+
+    if (free_pos == list->used)
+    {
+        list->used++;
+        list->free = GetFirstUnusedFreeElem(list);
+    }
+    else
+        list->free = (typename ListT::index_t) (CHANGE_SIGN * ListNext(list, free_pos));
+
+    return free_pos;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline void InitListElem(ListT* list, const size_t pos, typename ListT::data_t&& value,
+                                const size_t prev_pos, const size_t next_pos)
+{
+    assert(list);
+
+    typedef typename ListT::data_t  T;
+    typedef typename ListT::index_t index_t;
+
+    new (&ListData(list, pos)) T(std::move(value));
+    ListPrev(list, pos) = (index_t) prev_pos;
+    ListNext(list, pos) = (index_t) next_pos;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline void InitFreeListElem(ListT* list, const size_t pos, const size_t next_free)
+{
+    assert(list);
+
+    typedef typename ListT::data_t T;
+
+    if constexpr (ListPoison<T>::ENABLED)
+        ListData(list, pos) = ListPoison<T>::Value();
+
+    typedef typename ListT::index_t index_t;
+
+    ListPrev(list, pos) = -1;
+    ListNext(list, pos) = (index_t) (CHANGE_SIGN * (index_t) next_free);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline typename ListT::index_t GetFirstUnusedFreeElem(const ListT* list)
+{
+    assert(list);
+
+    typedef typename ListT::index_t index_t;
+
+    return (list->used < list->capacity) ? (index_t) list->used : (index_t) FICTIVE_ELEM_POS;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline void InitFictiveListElem(ListT* list, const size_t prev_pos, const size_t next_pos)
+{
+    assert(list);
+
+    typedef typename ListT::data_t T;
+
+    if constexpr (ListPoison<T>::ENABLED)
+        ListData(list, FICTIVE_ELEM_POS) = ListPoison<T>::Value();
+
+    ListPrev(list, FICTIVE_ELEM_POS) = (typename ListT::index_t) prev_pos;
+    ListNext(list, FICTIVE_ELEM_POS) = (typename ListT::index_t) next_pos;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline void UpdateNeighbourElems(ListT* list, const size_t pos)
+{
+    assert(list);
+
+    ListPrev(list, (size_t) ListNext(list, pos)) = (typename ListT::index_t) pos;
+    ListNext(list, (size_t) ListPrev(list, pos)) = (typename ListT::index_t) pos;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors ListRemoveElem(ListT* list, const size_t pos, ErrorInfo* error)
+{
+    assert(list);
+
+    typedef typename ListT::data_t T;
+
+    CHECK_LIST(list);
+
+    if constexpr (IsListChecked<ListT*>())
+    {
+        CheckRemovingElement(list, pos, error);
+        RETURN_IF_LISTERROR((ListErrors) error->code);
+    }
+
+    // removed tail slot becomes head of free list, so next append takes it back
+    list->linearized = list->linearized && pos == (size_t) GetListTail(list);
+
+    ListNext(list, (size_t) ListPrev(list, pos)) = ListNext(list, pos);
+    ListPrev(list, (size_t) ListNext(list, pos)) = ListPrev(list, pos);
+
+    RemoveListIndexEntry(list, pos);
+    RemoveListRankNode(list, pos);
+
+    ListData(list, pos).~T();
+
+    AddFreeElemInList(list, pos);
+    list->size--;
+
+    BumpListGeneration(list, pos);
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors GetListHandle(ListT* list, const size_t pos, list_handle_t* handle, ErrorInfo* error)
+{
+    assert(list);
+    assert(handle);
+    assert(error);
+
+    if (IsEmptyListElem(list, pos))
+    {
+        error->code = (int) ListErrors::EMPTY_ELEMENT;
+        error->data = list;
+        return ListErrors::EMPTY_ELEMENT;
+    }
+
+    // handle keeps only low half for slot
+    if (pos > LIST_SLOT_MASK)
+    {
+        error->code = (int) ListErrors::INDEX_OVERFLOW;
+        error->data = "HANDLE SLOT";
+        return ListErrors::INDEX_OVERFLOW;
+    }
+
+    if (list->extras == nullptr || pos >= list->extras->generations_capacity)
+    {
+        GrowListGenerations(list, pos, error);
+        RETURN_IF_LISTERROR((ListErrors) error->code);
+    }
+
+    *handle = ((list_handle_t) list->extras->generations[pos] << LIST_TAG_SHIFT) | (list_handle_t) pos;
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static ListErrors GrowListGenerations(ListT* list, const size_t pos, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    ListExtras* extras = GetListExtras(list, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    //                                                      v------ chunked list can be grown by concurrent slots
+    size_t capacity = (pos < list->capacity) ? list->capacity : pos + 1;
+
+    unsigned* generations = (unsigned*) realloc(extras->generations, capacity * sizeof(unsigned));
+    if (generations == nullptr)
+    {
+        error->code = (int) ListErrors::ALLOCATE_MEMORY;
+        error->data = "GENERATIONS ARRAY";
+        return ListErrors::ALLOCATE_MEMORY;
+    }
+
+    // slots after old capacity never had handles
+    memset(generations + extras->generations_capacity, 0,
+           (capacity - extras->generations_capacity) * sizeof(unsigned));
+
+    extras->generations          = generations;
+    extras->generations_capacity = capacity;
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline void BumpListGeneration(ListT* list, const size_t pos)
+{
+    assert(list);
+
+    if (list->extras != nullptr && pos < list->extras->generations_capacity)
+        list->extras->generations[pos]++;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void BumpListGenerations(ListT* list, const size_t end_pos)
+{
+    assert(list);
+
+    ListExtras* extras = list->extras;
+
+    if (extras == nullptr)
+        return;
+
+    // compaction moves elements, so every old handle becomes stale, ListRemap tells their new slots
+    size_t end = (end_pos < extras->generations_capacity) ? end_pos : extras->generations_capacity;
+
+    for (size_t pos = 1; pos < end; pos++)
+        extras->generations[pos]++;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+size_t GetListHandlePos(const ListT* list, const list_handle_t handle)
+{
+    assert(list);
+
+    size_t   pos        = (size_t) (handle & LIST_SLOT_MASK);
+    unsigned generation = (unsigned) (handle >> LIST_TAG_SHIFT);
+
+    const ListExtras* extras = list->extras;
+
+    // handle is taken only from busy slot and generation changes when slot is freed
+    if (pos == FICTIVE_ELEM_POS || extras == nullptr || pos >= extras->generations_capacity ||
+        extras->generations[pos] != generation)
+        return FICTIVE_ELEM_POS;
+
+    return pos;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors GetListElementByHandle(const ListT* list, const list_handle_t handle,
+                                  typename ListT::data_t* destination, ErrorInfo* error)
+{
+    assert(list);
+    assert(destination);
+    assert(error);
+
+    size_t pos = GetListHandlePos(list, handle);
+
+    if (pos == FICTIVE_ELEM_POS)
+    {
+        error->code = (int) ListErrors::STALE_HANDLE;
+        error->data = list;
+        return ListErrors::STALE_HANDLE;
+    }
+
+    *destination = ListData(list, pos);
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors ListRemoveByHandle(ListT* list, const list_handle_t handle, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    size_t pos = GetListHandlePos(list, handle);
+
+    if (pos == FICTIVE_ELEM_POS)
+    {
+        error->code = (int) ListErrors::STALE_HANDLE;
+        error->data = list;
+        return ListErrors::STALE_HANDLE;
+    }
+
+    return ListRemoveElem(list, pos, error);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void CheckRemovingElement(const ListT* list, const size_t pos, ErrorInfo* error)
+{
+    if (list->size == 0)
+    {
+        error->code = (int) ListErrors::EMPTY_LIST;
+        return;
+    }
+
+    if (IsEmptyListElem(list, pos))
+    {
+        error->code = (int) ListErrors::EMPTY_ELEMENT;
+        error->data = list;
+        return;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline void AddFreeElemInList(ListT* list, const size_t pos)
+{
+    assert(list);
+
+    InitFreeListElem(list, pos, (size_t) list->free);
+
+    list->free = (typename ListT::index_t) pos;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+void ListStartConcurrentSlots(ListT* list, ListConcurrentSlots* slots)
+{
+    assert(list);
+    assert(slots);
+
+    static_assert(ListT::LAYOUT == ListLayout::CHUNKED, "only chunked list never moves its slots");
+    assert(GetListValueIndex(list) == nullptr);
+    assert(GetListRankIndex(list) == nullptr);
+
+    // unused slots are given by used counter, so free stack ends with fictive element
+    SetFreeListEnd(list, list->used, FICTIVE_ELEM_POS);
+
+    size_t free_top = ((size_t) list->free == list->used) ? FICTIVE_ELEM_POS : (size_t) list->free;
+
+    slots->free_top.store(free_top, std::memory_order_relaxed);
+    slots->used.store(list->used, std::memory_order_relaxed);
+    slots->capacity.store(list->capacity, std::memory_order_relaxed);
+    slots->growing.store(false, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+void ListStopConcurrentSlots(ListT* list, ListConcurrentSlots* slots)
+{
+    assert(list);
+    assert(slots);
+
+    size_t capacity = slots->capacity.load(std::memory_order_acquire);
+    size_t used     = slots->used.load(std::memory_order_acquire);
+
+    assert(used <= capacity);
+
+    list->used     = used;
+    list->capacity = capacity;
+    list->free     = (typename ListT::index_t) (slots->free_top.load(std::memory_order_acquire) & LIST_SLOT_MASK);
+
+    SetFreeListEnd(list, FICTIVE_ELEM_POS, (size_t) GetFirstUnusedFreeElem(list));
+
+    if (list->free == FICTIVE_ELEM_POS)
+        list->free = GetFirstUnusedFreeElem(list);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void SetFreeListEnd(ListT* list, const size_t old_end, const size_t new_end)
+{
+    assert(list);
+
+    for (size_t pos = (size_t) list->free; pos != FICTIVE_ELEM_POS && pos != old_end; )
+    {
+        size_t next_pos = (size_t) (CHANGE_SIGN * ListNext(list, pos));
+
+        if (next_pos == old_end)
+        {
+            ListNext(list, pos) = (typename ListT::index_t) (CHANGE_SIGN * (typename ListT::index_t) new_end);
+            return;
+        }
+
+        pos = next_pos;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors ListReserveSlot(ListT* list, ListConcurrentSlots* slots, typename ListT::data_t value,
+                           size_t* reserved_pos, ErrorInfo* error)
+{
+    assert(list);
+    assert(slots);
+    assert(reserved_pos);
+    assert(error);
+
+    unsigned long long top = slots->free_top.load(std::memory_order_acquire);
+    size_t             pos = FICTIVE_ELEM_POS;
+
+    while ((top & LIST_SLOT_MASK) != FICTIVE_ELEM_POS)
+    {
+        pos = (size_t) (top & LIST_SLOT_MASK);
+
+        // slot can be taken by other thread right now, then its next is stale, but tag fails exchange
+        auto   next_free = __atomic_load_n(&ListNext(list, pos), __ATOMIC_RELAXED);
+        size_t next_pos  = (size_t) (CHANGE_SIGN * next_free);
+
+        if (slots->free_top.compare_exchange_weak(top, MakeTaggedSlot(top, next_pos),
+                                                  std::memory_order_acquire, std::memory_order_acquire))
+            break;
+
+        pos = FICTIVE_ELEM_POS;
+    }
+
+    if (pos == FICTIVE_ELEM_POS && ReserveUnusedSlot(list, slots, &pos) != ListErrors::NONE)
+    {
+        error->code = (int) ListErrors::ALLOCATE_MEMORY;
+        error->data = "ELEMENTS CHUNK";
+        return ListErrors::ALLOCATE_MEMORY;
+    }
+
+    typedef typename ListT::data_t T;
+
+    // reserved slot is not free, but it is not linked yet,
+    // its next can still be read by thread with stale top, so it is written atomically
+    new (&ListData(list, pos)) T(std::move(value));
+    ListPrev(list, pos) = (typename ListT::index_t) FICTIVE_ELEM_POS;
+    __atomic_store_n(&ListNext(list, pos), (typename ListT::index_t) FICTIVE_ELEM_POS, __ATOMIC_RELAXED);
+
+    *reserved_pos = pos;
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static ListErrors ReserveUnusedSlot(ListT* list, ListConcurrentSlots* slots, size_t* reserved_pos)
+{
+    assert(list);
+    assert(slots);
+    assert(reserved_pos);
+
+    size_t pos = slots->used.load(std::memory_order_relaxed);
+
+    // counter is moved only over allocated slots, so failed growth takes nothing and next call tries again;
+    // existing chunks are never moved, so growth blocks only threads, which wait for new slots
+    while (true)
+    {
+        if (pos < slots->capacity.load(std::memory_order_acquire))
+        {
+            if (slots->used.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+
+            continue;
+        }
+
+        if (slots->growing.exchange(true, std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+            pos = slots->used.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        size_t capacity  = slots->capacity.load(std::memory_order_relaxed);
+        bool   allocated = true;
+
+        if (capacity <= pos)
+        {
+            allocated = AllocListChunks(list, capacity, capacity + LIST_CHUNK_ELEMS);
+
+            if (allocated)
+                slots->capacity.store(capacity + LIST_CHUNK_ELEMS, std::memory_order_release);
+        }
+
+        slots->growing.store(false, std::memory_order_release);
+
+        if (!allocated)
+            return ListErrors::ALLOCATE_MEMORY;
+
+        pos = slots->used.load(std::memory_order_relaxed);
+    }
+
+    *reserved_pos = pos;
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+void ListReleaseSlot(ListT* list, ListConcurrentSlots* slots, const size_t pos)
+{
+    assert(list);
+    assert(slots);
+
+    typedef typename ListT::data_t T;
+
+    ListData(list, pos).~T();
+
+    if constexpr (ListPoison<T>::ENABLED)
+        ListData(list, pos) = ListPoison<T>::Value();
+
+    ListPrev(list, pos) = -1;
+
+    // released slot belongs only to this thread, generations array is not grown while slots are started
+    BumpListGeneration(list, pos);
+
+    unsigned long long top = slots->free_top.load(std::memory_order_relaxed);
+
+    do
+    {
+        auto next_free = (typename ListT::index_t) (CHANGE_SIGN * (long long) (top & LIST_SLOT_MASK));
+        __atomic_store_n(&ListNext(list, pos), next_free, __ATOMIC_RELAXED);
+    }
+    while (!slots->free_top.compare_exchange_weak(top, MakeTaggedSlot(top, pos),
+                                                  std::memory_order_release, std::memory_order_relaxed));
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static inline unsigned long long MakeTaggedSlot(const unsigned long long old_top, const size_t pos)
+{
+    //                                  v------ every change of top gets new tag, so ABA is not possible
+    unsigned long long tag = (old_top >> LIST_TAG_SHIFT) + 1;
+
+    return (tag << LIST_TAG_SHIFT) | (unsigned long long) pos;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+void ListLinkSlotAfter(ListT* list, const size_t pos, const size_t slot)
+{
+    assert(list);
+
+    list->linearized = list->linearized && pos == (size_t) GetListTail(list) && slot == list->size + 1;
+
+    ListPrev(list, slot) = (typename ListT::index_t) pos;
+    ListNext(list, slot) = ListNext(list, pos);
+    UpdateNeighbourElems(list, slot);
+
+    list->size++;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+void ListUnlinkSlot(ListT* list, const size_t pos)
+{
+    assert(list);
+
+    list->linearized = list->linearized && pos == (size_t) GetListTail(list);
+
+    ListNext(list, (size_t) ListPrev(list, pos)) = ListNext(list, pos);
+    ListPrev(list, (size_t) ListNext(list, pos)) = ListPrev(list, pos);
+
+    ListNext(list, pos) = FICTIVE_ELEM_POS;
+    ListPrev(list, pos) = FICTIVE_ELEM_POS;
+
+    list->size--;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+int ListDump(FILE* fp, const void* fast_list, const char* func, const char* file, const int line)
+{
+    assert(fast_list);
+
+    LOG_START_DUMP(func, file, line);
+
+    const ListT* list = (const ListT*) fast_list;
+
+    // dump of huge list would be gigabytes of html, that graphviz never renders
+    if (list->capacity > MAX_FULL_DUMP_CAPACITY)
+    {
+        ListDumpRequest request = {list, ListDumpMode::ENDS, 0, DEFAULT_DUMPED_ENDS};
+
+        fprintf(fp, "LIST IS TOO BIG, ONLY ITS ENDS ARE DUMPED<br>\n");
+        DumpListPart(fp, list, &request);
+
+        LOG_END();
+        return (int) ListErrors::NONE;
+    }
+
+    TextListDump(fp, list, nullptr, list->capacity);
+    DrawListGraph(list, nullptr, list->capacity);
+
+    LOG_END();
+
+    return (int) ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+int ListPartDump(FILE* fp, const void* dump_request, const char* func, const char* file, const int line)
+{
+    assert(dump_request);
+
+    const ListDumpRequest* request = (const ListDumpRequest*) dump_request;
+    const ListT*           list    = (const ListT*) request->list;
+
+    assert(list);
+
+    if (request->mode == ListDumpMode::FULL)
+        return ListDump<ListT>(fp, list, func, file, line);
+
+    LOG_START_DUMP(func, file, line);
+
+    DumpListPart(fp, list, request);
+
+    LOG_END();
+
+    return (int) ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void DumpListPart(FILE* fp, const ListT* list, const ListDumpRequest* request)
+{
+    assert(list);
+    assert(request);
+
+    size_t slots[MAX_DUMPED_SLOTS] = {};
+    size_t slots_amt               = SelectDumpedSlots(list, request, slots);
+
+    // summary walks whole list, so bounded dumps print only fields stored in list
+    fprintf(fp, "<pre>");
+    if (request->mode == ListDumpMode::SUMMARY)
+        PrintListSummary(fp, list);
+    else
+        PrintListSizes(fp, list);
+    fprintf(fp, "</pre>");
+
+    if (request->mode != ListDumpMode::SUMMARY)
+    {
+        TextListDump(fp, list, slots, slots_amt);
+        DrawListGraph(list, slots, slots_amt);
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+int PrintListError(FILE* fp, const void* err, const char* func, const char* file, const int line)
+{
+    assert(err);
+
+    LOG_START(func, file, line);
+
+    const struct ErrorInfo* error = (const struct ErrorInfo*) err;
+
+    switch ((ListErrors) error->code)
+    {
+        case (ListErrors::NONE):
+            LOG_END();
+            return (int) error->code;
+
+        case (ListErrors::EMPTY_LIST):
+            fprintf(fp, "CAN NOT REMOVE ELEMENT FROM EMPTY LIST<br>\n");
+            LOG_END();
+            return (int) error->code;
+
+        case (ListErrors::ALLOCATE_MEMORY):
+            fprintf(fp, "CAN NOT ALLOCATE MEMORY FOR %s FROM LIST<br>\n", (const char*) error->data);
+            LOG_END();
+            return (int) error->code;
+
+        case (ListErrors::EMPTY_ELEMENT):
+            fprintf(fp, "CAN NOT OPERATE WITH ALREADY EMPTY ELEMENT<br>\n");
+            DUMP_LIST((const ListT*) error->data);
+            LOG_END();
+            return (int) error->code;
+
+        case (ListErrors::INVALID_SIZE):
+            fprintf(fp, "INVALID LIST SIZE<br>\n");
+            DUMP_LIST((const ListT*) error->data);
+            LOG_END();
+            return (int) error->code;
+
+        case (ListErrors::INVALID_INDEX):
+            fprintf(fp, "ELEMENT INDEX IS OUT OF LIST<br>\n");
+            DUMP_LIST((const ListT*) error->data);
+            LOG_END();
+            return (int) error->code;
+
+        case (ListErrors::DAMAGED_LINKS):
+            fprintf(fp, "LIST LINKS ARE DAMAGED<br>\n");
+            LOG_END();
+            return (int) error->code;
+
+        case (ListErrors::STALE_HANDLE):
+            fprintf(fp, "HANDLE OF REMOVED OR MOVED ELEMENT<br>\n");
+            DUMP_LIST((const ListT*) error->data);
+            LOG_END();
+            return (int) error->code;
+
+        case (ListErrors::MISSING_VALUE):
+            fprintf(fp, "LIST HAS NO ELEMENT WITH VALUE<br>\n");
+            LOG_END();
+            return (int) error->code;
+
+        case (ListErrors::INDEX_OVERFLOW):
+            fprintf(fp, "%s DOES NOT FIT IN INDEX TYPE OF LIST<br>\n", (const char*) error->data);
+            LOG_END();
+            return (int) error->code;
+
+        case (ListErrors::INVALID_CURSOR):
+            fprintf(fp, "CURSOR IS NOT A PAIR OF NEIGHBOUR ELEMENTS OF LIST<br>\n");
+            LOG_END();
+            return (int) error->code;
+
+        case (ListErrors::UNKNOWN):
+        // fall through
+        default:
+            fprintf(fp, "UNKNOWN ERROR WITH LIST<br>\n");
+            LOG_END();
+            return (int) ListErrors::UNKNOWN;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <typename T>
+void PrintListValue(FILE* fp, const T& /* value */, const int width)
+{
+    fprintf(fp, "%*s", width, "OBJ");
+}
+
+//====================================================================================================
+
+template <class ListT>
+static void TextListDump(FILE* fp, const ListT* list, const size_t* slots, const size_t slots_amt)
+{
+    fprintf(fp, "<pre>");
+
+    fprintf(fp, "<b>DUMPING LIST</b><br>\n");
+
+    PrintListElements(fp, list, slots, slots_amt);
+    PrintListInfo(fp, list);
+
+    fprintf(fp, "</pre>");
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+template <class ListT>
+static inline void PrintListInfo(FILE* fp, const ListT* list)
+{
+    assert(list);
+
+    fprintf(fp, "HEAD     > %lld<br>\n"
+                "TAIL     > %lld<br>\n"
+                "FREE     > %lld<br>\n"
+                "CAPACITY > %lu<br>\n", (long long) GetListHead(list), (long long) GetListTail(list),
+                                        (long long) list->free, list->capacity);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+template <class ListT>
+static inline void PrintListElements(FILE* fp, const ListT* list, const size_t* slots, const size_t slots_amt)
+{
+    assert(list);
+    fprintf(fp, "       <b>DATA  NEXT  PREV </b><br>\n");
+
+    for (size_t slot = 0; slot < slots_amt; slot++)
+    {
+        size_t i = GetDumpedSlot(slots, slot);
+
+        ChooseElementHtmlColor(fp, list, i);
+
+        fprintf(fp, "%3lu -> [", i);
+
+        if (!IsEmptyListElem(list, i))
+            PrintListValue(fp, ListData(list, i), 3);
+        else
+            fprintf(fp, "NaN");
+
+        fprintf(fp, ", %3lld, %3lld]</b></font>\n", GetDumpedNext(list, i), GetDumpedPrev(list, i));
+    }
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+template <class ListT>
+static void PrintListSummary(FILE* fp, const ListT* list)
+{
+    assert(list);
+
+    // links, which do not go to the next slot, and the longest link back to the start of array
+    size_t breaks    = 0;
+    size_t back_jump = 0;
+
+    size_t pos = (size_t) GetListHead(list);
+    for (size_t i = 1; i < list->size; i++)
+    {
+        size_t next_pos = (size_t) ListNext(list, pos);
+
+        if (next_pos != pos + 1)
+            breaks++;
+
+        if (next_pos < pos && pos - next_pos > back_jump)
+            back_jump = pos - next_pos;
+
+        pos = next_pos;
+    }
+
+    // free list ends with first unused slot, every unused slot is free too
+    size_t free_list_len = 0;
+    for (size_t free_pos = (size_t) list->free;
+         free_pos != FICTIVE_ELEM_POS && free_pos < list->used && free_list_len < list->capacity;
+         free_pos = (size_t) (CHANGE_SIGN * ListNext(list, free_pos)))
+        free_list_len++;
+
+    double fragmentation = (list->size > 1) ? 100.0 * (double) breaks / (double) (list->size - 1) : 0;
+
+    fprintf(fp, "<b>LIST SUMMARY</b><br>\n"
+                "SIZE            > %lu<br>\n"
+                "CAPACITY        > %lu<br>\n"
+                "USED SLOTS      > %lu<br>\n"
+                "FREE LIST       > %lu<br>\n"
+                "LINEARIZED      > %s<br>\n"
+                "FRAGMENTATION   > %.2lf%%<br>\n"
+                "LONGEST BACK    > %lu<br>\n",
+                list->size, list->capacity, list->used, free_list_len, list->linearized ? "YES" : "NO",
+                fragmentation, back_jump);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+template <class ListT>
+static inline void PrintListSizes(FILE* fp, const ListT* list)
+{
+    assert(list);
+
+    fprintf(fp, "SIZE       > %lu<br>\n"
+                "USED SLOTS > %lu<br>\n", list->size, list->used);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+template <class ListT>
+static size_t SelectDumpedSlots(const ListT* list, const ListDumpRequest* request, size_t* slots)
+{
+    assert(list);
+    assert(request);
+    assert(slots);
+
+    size_t amount = request->amount;
+    //                                      v------ fictive element is dumped too
+    if (2 * amount + 1 > MAX_DUMPED_SLOTS)
+        amount = (MAX_DUMPED_SLOTS - 1) / 2;
+
+    size_t slots_amt = 0;
+
+    if (request->mode == ListDumpMode::WINDOW)
+    {
+        size_t first = (request->pos > amount) ? request->pos - amount : 0;
+
+        for (size_t pos = first; pos <= request->pos + amount && pos < list->capacity; pos++)
+            slots[slots_amt++] = pos;
+    }
+    else if (request->mode == ListDumpMode::ENDS)
+    {
+        slots[slots_amt++] = FICTIVE_ELEM_POS;
+
+        size_t head_amt = (list->size < 2 * amount) ? list->size : amount;
+        size_t tail_amt = (list->size < 2 * amount) ? 0          : amount;
+
+        for (size_t i = 0, pos = (size_t) GetListHead(list); i < head_amt; i++, pos = (size_t) ListNext(list, pos))
+            slots[slots_amt++] = pos;
+
+        // tail is collected backwards to keep logical order
+        for (size_t i = 0, pos = (size_t) GetListTail(list); i < tail_amt; i++, pos = (size_t) ListPrev(list, pos))
+            slots[slots_amt + tail_amt - 1 - i] = pos;
+
+        slots_amt += tail_amt;
+    }
+
+    return slots_amt;
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+static inline size_t GetDumpedSlot(const size_t* slots, const size_t i)
+{
+    //              v------ full dump has no slots array
+    return (slots == nullptr) ? i : slots[i];
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+template <class ListT>
+static inline long long GetDumpedNext(const ListT* list, const size_t pos)
+{
+    assert(list);
+
+    if (pos < list->used)
+        return ListNext(list, pos);
+
+    //          unused slots are shown like they are linked one by one ------v
+    return (pos + 1 < list->capacity) ? CHANGE_SIGN * (long long) (pos + 1) : (long long) FICTIVE_ELEM_POS;
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+template <class ListT>
+static inline long long GetDumpedPrev(const ListT* list, const size_t pos)
+{
+    assert(list);
+
+    return (pos < list->used) ? ListPrev(list, pos) : -1;
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+template <class ListT>
+static inline void ChooseElementHtmlColor(FILE* fp, const ListT* list, const size_t pos)
+{
+    assert(list);
+
+    if (GetDumpedPrev(list, pos) == -1)
+        fprintf(fp, "<font color=\"#008000\"><b>");
+    else if (pos == FICTIVE_ELEM_POS)
+        fprintf(fp, "<font color=\"#474747\"><b>");
+    else
+        fprintf(fp, "<font color=\"#0000FF\"><b>");
+}
+
+//====================================================================================================
+
+template <class ListT>
+static void DrawListGraph(const ListT* list, const size_t* slots, const size_t slots_amt)
+{
+    assert(list);
+
+    // dumped slots are only copied here, graph worker writes their graph and renders it
+    ListGraphSnapshot<typename ListT::data_t>* snapshot = MakeListGraphSnapshot(list, slots, slots_amt);
+
+    if (snapshot == nullptr)
+    {
+        PrintLog("CAN NOT COPY LIST FOR GRAPH<br>\n");
+        return;
+    }
+
+    QueueGraphDump(DrawListSnapshot<typename ListT::data_t>, snapshot);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+template <class ListT>
+static ListGraphSnapshot<typename ListT::data_t>* MakeListGraphSnapshot(const ListT* list, const size_t* slots,
+                                                                        const size_t slots_amt)
+{
+    assert(list);
+
+    typedef typename ListT::data_t T;
+
+    ListGraphSnapshot<T>* snapshot = (ListGraphSnapshot<T>*) calloc(1, sizeof(ListGraphSnapshot<T>));
+    if (snapshot == nullptr)
+        return nullptr;
+
+    snapshot->slots = (ListGraphSlot<T>*) calloc(slots_amt + 1, sizeof(ListGraphSlot<T>));
+    if (snapshot->slots == nullptr)
+    {
+        free(snapshot);
+        return nullptr;
+    }
+
+    snapshot->head      = (long long) GetListHead(list);
+    snapshot->tail      = (long long) GetListTail(list);
+    snapshot->free      = (long long) list->free;
+    snapshot->size      = list->size;
+    snapshot->capacity  = list->capacity;
+    snapshot->slots_amt = slots_amt;
+
+    for (size_t i = 0; i < slots_amt; i++)
+    {
+        ListGraphSlot<T>* slot = &snapshot->slots[i];
+
+        slot->pos   = GetDumpedSlot(slots, i);
+        slot->next  = GetDumpedNext(list, slot->pos);
+        slot->prev  = GetDumpedPrev(list, slot->pos);
+        slot->empty = IsEmptyListElem(list, slot->pos);
+
+        if (!slot->empty)
+            new (&slot->data) T(ListData(list, slot->pos));
+    }
+
+    return snapshot;
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+template <typename T>
+static void DrawListSnapshot(FILE* dotf, void* graph)
+{
+    assert(graph);
+
+    ListGraphSnapshot<T>* snapshot = (ListGraphSnapshot<T>*) graph;
+
+    if (dotf != nullptr)
+    {
+        StartGraph(dotf);
+        DrawListInfo(dotf, snapshot);
+        DrawListElements(dotf, snapshot);
+        CenterListElements(dotf, snapshot);
+        DrawListArrows(dotf, snapshot);
+        EndGraph(dotf);
+    }
+
+    if constexpr (!std::is_trivially_destructible<T>::value)
+    {
+        for (size_t i = 0; i < snapshot->slots_amt; i++)
+        {
+            if (!snapshot->slots[i].empty)
+                snapshot->slots[i].data.~T();
+        }
+    }
+
+    free(snapshot->slots);
+    free(snapshot);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+template <typename T>
+static inline void DrawListInfo(FILE* dotf, const ListGraphSnapshot<T>* snapshot)
+{
+    assert(snapshot);
+
+    fprintf(dotf, "info [shape=record, style=filled, fillcolor=\"yellow\","
+                  "label=\"HEAD: %lld | TAIL: %lld | FREE: %lld | SIZE: %lu | CAPACITY: %lu\","
+                  "fontcolor = \"black\", fontsize = 25];\n",
+                              snapshot->head, snapshot->tail, snapshot->free,
+                              snapshot->size, snapshot->capacity);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+template <typename T>
+static inline void ChooseVertexColor(FILE* dotf, const ListGraphSlot<T>* slot)
+{
+    assert(slot);
+
+    if (slot->prev == -1)
+        fprintf(dotf, "fillcolor=\"lightgreen\", color = darkgreen,");
+    else if (slot->pos == FICTIVE_ELEM_POS)
+        fprintf(dotf, "fillcolor=\"lightgray\", color = black,");
+    else
+        fprintf(dotf, "fillcolor=\"lightblue\", color = darkblue,");
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+template <typename T>
+static inline void MarkImportantElements(FILE* dotf, const ListGraphSnapshot<T>* snapshot, const ListGraphSlot<T>* slot)
+{
+    assert(snapshot);
+    assert(slot);
+
+    if (slot->pos == (size_t) snapshot->free)
+        fprintf(dotf, "FREE | ");
+
+    if (slot->pos == (size_t) snapshot->head)
+        fprintf(dotf, "HEAD | ");
+
+    if (slot->pos == (size_t) snapshot->tail)
+        fprintf(dotf, "TAIL | ");
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+template <typename T>
+static inline void DrawListElements(FILE* dotf, const ListGraphSnapshot<T>* snapshot)
+{
+    assert(snapshot);
+
+    for (size_t i = 0; i < snapshot->slots_amt; i++)
+    {
+        const ListGraphSlot<T>* slot = &snapshot->slots[i];
+
+        fprintf(dotf, "%lu [shape=Mrecord, style=filled, ", slot->pos);
+
+        ChooseVertexColor(dotf, slot);
+
+        fprintf(dotf, " label=\" ");
+
+        MarkImportantElements(dotf, snapshot, slot);
+
+        fprintf(dotf, "ip: %lu | data: ", slot->pos);
+
+        if (slot->empty)
+            fprintf(dotf, "NaN");
+        else
+            PrintListValue(dotf, slot->data, 0);
+
+        fprintf(dotf, "| next: %lld| prev: %lld\" ];\n", slot->next, slot->prev);
+    }
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+template <typename T>
+static inline void CenterListElements(FILE* dotf, const ListGraphSnapshot<T>* snapshot)
+{
+    assert(snapshot);
+
+    if (snapshot->slots_amt == 0)
+        return;
+
+    fprintf(dotf, "%lu", snapshot->slots[0].pos);
+    for (size_t i = 1; i < snapshot->slots_amt; i++)
+    {
+        fprintf(dotf, "->%lu", snapshot->slots[i].pos);
+    }
+    fprintf(dotf, "[weight = 993, color = \"white\"];\n");
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
+
+template <typename T>
+static inline void DrawListArrows(FILE* dotf, const ListGraphSnapshot<T>* snapshot)
+{
+    assert(snapshot);
+
+    // arrows to slots, which are not dumped, lead to plain nodes with their numbers
+    for (size_t i = 0; i < snapshot->slots_amt; i++)
+    {
+        const ListGraphSlot<T>* slot = &snapshot->slots[i];
+
+        if (slot->prev != -1)
+            fprintf(dotf, "%lu -> %lld [weight = 0, color = \"red\", constraint = false];\n",
+                            slot->pos, slot->prev);
+
+        // only tail links to fictive element, other links to it end free list
+        long long next = slot->next;
+        if (next < 0 || (next == 0 && (size_t) snapshot->tail != slot->pos))
+        {
+            next *= CHANGE_SIGN;
+            fprintf(dotf, "%lu -> %lld [weight = 0, color = \"green\", constraint = false];\n", slot->pos, next);
+        }
+        else
+            fprintf(dotf, "%lu -> %lld [weight = 0, color = \"blue\", constraint = false];\n", slot->pos, next);
+    }
+}
+
+#endif
@@ -1,5 +1,10 @@
+#include <assert.h>
 #include <stdlib.h>
-#include <time.h>
+#include <string.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include "graphs.h"
 #include "logs.h"
@@ -7,6 +12,38 @@
 static size_t      IMG_CNT        = 1;
 static const char* IMG_FOLDER_DIR = "img/";
 
+/// queued graph, its image is named by number
+struct QueuedGraph
+{
+    QueuedGraph* next;
+
+    size_t number;
+
+    draw_graph_f draw_func;
+    void*        snapshot;
+};
+
+// background worker, which renders queued graphs
+
+static std::mutex              WORKER_LOCK;
+static std::condition_variable GRAPH_ADDED;
+static std::condition_variable GRAPHS_RENDERED;
+static std::thread             WORKER_THREAD;
+
+static QueuedGraph* FIRST_QUEUED    = nullptr;
+static QueuedGraph* LAST_QUEUED     = nullptr;
+static size_t       QUEUED_CNT      = 0;
+
+static bool         WORKER_STARTED  = false;
+static bool         RENDERING       = false;
+static bool         WORKER_STOPPING = false;
+
+static void RunGraphWorker();
+static void StopGraphWorker();
+static void RenderGraphs(QueuedGraph* graphs);
+static void WriteDotFile(const QueuedGraph* graph, char* dot_name);
+static void WriteGraphText(FILE* dotf, void* text);
+
 //---------------------------------------------------------------------------------------
 
 void EndGraph(FILE* dotf)
@@ -27,14 +64,213 @@ void StartGraph(FILE* dotf)
 
 //---------------------------------------------------------------------------------------
 
-void MakeImgFromDot(const char* dot_file)
+void StartGraphDump(GraphDump* dump)
+{
+    assert(dump);
+
+    dump->text   = nullptr;
+    dump->length = 0;
+    dump->dotf   = open_memstream(&dump->text, &dump->length);
+
+    if (dump->dotf != nullptr)
+        StartGraph(dump->dotf);
+}
+
+//---------------------------------------------------------------------------------------
+
+void EndGraphDump(GraphDump* dump)
+{
+    assert(dump);
+
+    if (dump->dotf == nullptr)
+    {
+        PrintLog("CAN NOT OPEN DOT FILE<br>\n");
+        return;
+    }
+
+    EndGraph(dump->dotf);
+    fclose(dump->dotf);
+    dump->dotf = nullptr;
+
+    QueueGraphDump(WriteGraphText, dump->text);
+}
+
+//---------------------------------------------------------------------------------------
+
+void QueueGraphDump(draw_graph_f draw_func, void* snapshot)
+{
+    assert(draw_func);
+    assert(snapshot);
+
+    QueuedGraph* graph = (QueuedGraph*) calloc(1, sizeof(QueuedGraph));
+    if (graph == nullptr)
+    {
+        draw_func(nullptr, snapshot);
+        return;
+    }
+
+    graph->draw_func = draw_func;
+    graph->snapshot  = snapshot;
+
+    std::unique_lock<std::mutex> guard(WORKER_LOCK);
+
+    if (QUEUED_CNT >= MAX_QUEUED_GRAPHS)
+    {
+        guard.unlock();
+
+        PrintLog("GRAPH IS SKIPPED, TOO MANY GRAPHS ARE WAITING FOR DOT<br>\n");
+        draw_func(nullptr, snapshot);
+        free(graph);
+        return;
+    }
+
+    size_t number = IMG_CNT++;
+    graph->number = number;
+
+    if (LAST_QUEUED == nullptr)
+        FIRST_QUEUED      = graph;
+    else
+        LAST_QUEUED->next = graph;
+
+    LAST_QUEUED = graph;
+    QUEUED_CNT++;
+
+    if (!WORKER_STARTED)
+    {
+        WORKER_STARTED = true;
+        WORKER_THREAD  = std::thread(RunGraphWorker);
+
+        atexit(StopGraphWorker);
+    }
+
+    guard.unlock();
+    GRAPH_ADDED.notify_one();
+
+    //                                      v------ dot -O appends format to input file name
+    PrintLog("<img src=\"%simg%lu.dot.png\"><br>", IMG_FOLDER_DIR, number);
+}
+
+//---------------------------------------------------------------------------------------
+
+void FlushGraphDumps()
+{
+    std::unique_lock<std::mutex> guard(WORKER_LOCK);
+
+    GRAPHS_RENDERED.wait(guard, [] { return FIRST_QUEUED == nullptr && !RENDERING; });
+}
+
+//---------------------------------------------------------------------------------------
+
+static void StopGraphWorker()
+{
+    // log refers to images of all queued graphs, so they are rendered before worker stops
+    FlushGraphDumps();
+
+    std::unique_lock<std::mutex> guard(WORKER_LOCK);
+
+    WORKER_STOPPING = true;
+
+    guard.unlock();
+    GRAPH_ADDED.notify_one();
+
+    WORKER_THREAD.join();
+}
+
+//---------------------------------------------------------------------------------------
+
+static void RunGraphWorker()
 {
-    char img_name[MAX_IMG_FILE_LEN] = {};
-    snprintf(img_name, MAX_IMG_FILE_LEN, "%simg%lu_%lu.png", IMG_FOLDER_DIR, IMG_CNT++, clock());
+    while (true)
+    {
+        std::unique_lock<std::mutex> guard(WORKER_LOCK);
+
+        GRAPH_ADDED.wait(guard, [] { return FIRST_QUEUED != nullptr || WORKER_STOPPING; });
+
+        if (FIRST_QUEUED == nullptr)
+            return;
+
+        QueuedGraph* batch = FIRST_QUEUED;
+        QueuedGraph* last  = batch;
+
+        for (size_t i = 1; i < MAX_DOT_BATCH && last->next != nullptr; i++)
+            last = last->next;
+
+        FIRST_QUEUED = last->next;
+        if (FIRST_QUEUED == nullptr)
+            LAST_QUEUED = nullptr;
+
+        last->next = nullptr;
+        RENDERING  = true;
+
+        guard.unlock();
+
+        RenderGraphs(batch);
+
+        guard.lock();
+
+        for (QueuedGraph* graph = batch; graph != nullptr; QUEUED_CNT--)
+        {
+            QueuedGraph* next = graph->next;
+
+            free(graph);
+
+            graph = next;
+        }
+
+        RENDERING = false;
+
+        guard.unlock();
+        GRAPHS_RENDERED.notify_all();
+    }
+}
+
+//---------------------------------------------------------------------------------------
+
+static void RenderGraphs(QueuedGraph* graphs)
+{
+    assert(graphs);
+
+    char dot_command[MAX_DOT_CMD_LEN + MAX_DOT_BATCH * MAX_IMG_FILE_LEN] = "dot -T png -O";
+    size_t command_len = strlen(dot_command);
+
+    for (QueuedGraph* graph = graphs; graph != nullptr; graph = graph->next)
+    {
+        char dot_name[MAX_IMG_FILE_LEN] = {};
+        WriteDotFile(graph, dot_name);
+
+        command_len += (size_t) snprintf(dot_command + command_len, MAX_IMG_FILE_LEN, " %s", dot_name);
+    }
 
-    char dot_command[MAX_DOT_CMD_LEN] = {};
-    snprintf(dot_command, MAX_DOT_CMD_LEN, "dot %s -T png -o %s", dot_file, img_name);
     system(dot_command);
+}
+
+//---------------------------------------------------------------------------------------
+
+static void WriteDotFile(const QueuedGraph* graph, char* dot_name)
+{
+    assert(graph);
+    assert(dot_name);
+
+    snprintf(dot_name, MAX_IMG_FILE_LEN, "%simg%lu.dot", IMG_FOLDER_DIR, graph->number);
+
+    // graph text is made here, so caller of dump only copies its object
+    FILE* dotf = fopen(dot_name, "w");
+
+    graph->draw_func(dotf, graph->snapshot);
+
+    if (dotf != nullptr)
+        fclose(dotf);
+}
+
+//---------------------------------------------------------------------------------------
+
+static void WriteGraphText(FILE* dotf, void* text)
+{
+    assert(text);
+
+    // memstream keeps null terminated text
+    if (dotf != nullptr)
+        fputs((const char*) text, dotf);
 
-    PrintLog("<img src=\"%s\"><br>", img_name);
+    free(text);
 }
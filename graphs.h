@@ -3,12 +3,56 @@
 
 #include <stdio.h>
 
-static const size_t MAX_DOT_CMD_LEN  = 200;
-static const size_t MAX_IMG_FILE_LEN = 100;
+static const size_t MAX_DOT_CMD_LEN     = 200;
+static const size_t MAX_IMG_FILE_LEN    = 100;
+
+static const size_t MAX_DOT_BATCH       = 16;     ///< graphs rendered by one dot call
+static const size_t MAX_QUEUED_GRAPHS   = 256;    ///< next graphs are skipped until worker catches up
+
+/// writes whole graph from snapshot in dot file and frees snapshot,
+/// dot file is nullptr, when graph is skipped, then snapshot is only freed
+typedef void (*draw_graph_f)(FILE* dotf, void* snapshot);
+
+/// graph, which is written in memory and rendered later by background worker
+struct GraphDump
+{
+    FILE*  dotf;
+
+    char*  text;
+    size_t length;
+};
 
 void StartGraph(FILE* dotf);
 void EndGraph(FILE* dotf);
 
-void MakeImgFromDot(const char* dot_file);
+/************************************************************//**
+ * @brief Opens in-memory dot file and starts graph in it
+ *
+ * @param[out] dump graph dump, its dotf is written by caller
+ ************************************************************/
+void StartGraphDump(GraphDump* dump);
+
+/************************************************************//**
+ * @brief Ends graph, prints its future image in log and gives it
+ * to background worker, caller does not wait for dot
+ *
+ * @param[in] dump graph dump
+ ************************************************************/
+void EndGraphDump(GraphDump* dump);
+
+/************************************************************//**
+ * @brief Gives copy of dumped object to background worker, which
+ * writes its graph and renders it, prints its future image in log
+ *
+ * @param[in] draw_func function, which writes graph from snapshot
+ * @param[in] snapshot copy of object, it is owned by worker now
+ ************************************************************/
+void QueueGraphDump(draw_graph_f draw_func, void* snapshot);
+
+/************************************************************//**
+ * @brief Waits until all queued graphs are rendered, it is called
+ * by code, which reads images before exit, and when worker stops at exit
+ ************************************************************/
+void FlushGraphDumps();
 
 #endif
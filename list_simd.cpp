@@ -0,0 +1,541 @@
+#include <assert.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LIST_SIMD_X86 1
+#else
+#define LIST_SIMD_X86 0
+#endif
+
+#include "list_simd.h"
+
+static const size_t SSE_INTS  = 4;
+static const size_t AVX2_INTS = 8;
+
+static size_t FindIntValueScalar(const int* data, const size_t amount, const size_t stride, const int value);
+static size_t CountIntValueScalar(const int* data, const size_t amount, const size_t stride, const int value);
+static void   AggregateIntsScalar(const int* data, const size_t amount, const size_t stride, const int skipped,
+                                  IntAggregates* aggregates);
+
+#if LIST_SIMD_X86
+
+static bool HasAvx2();
+
+static inline unsigned MatchIntsSse(const int* ints, const __m128i value, const int lanes);
+static size_t FindIntValueSse(const int* data, const size_t amount, const size_t stride, const int value);
+static size_t CountIntValueSse(const int* data, const size_t amount, const size_t stride, const int value);
+
+__attribute__((target("avx2")))
+static inline unsigned MatchIntsAvx2(const int* ints, const __m256i value, const int lanes);
+__attribute__((target("avx2")))
+static size_t FindIntValueAvx2(const int* data, const size_t amount, const size_t stride, const int value);
+__attribute__((target("avx2")))
+static size_t CountIntValueAvx2(const int* data, const size_t amount, const size_t stride, const int value);
+
+/// vector accumulators of aggregates, sums are kept in 64-bit lanes
+struct SseAggregates
+{
+    __m128i sum;
+    __m128i min;
+    __m128i max;
+    size_t  count;
+};
+
+struct Avx2Aggregates
+{
+    __m256i sum;
+    __m256i min;
+    __m256i max;
+    size_t  count;
+};
+
+static inline __m128i GetLanesSse(const int lanes);
+static inline void    AggregateVectorSse(const int* ints, const __m128i lanes, const __m128i skipped,
+                                         SseAggregates* vec_aggregates);
+static void           AggregateIntsSse(const int* data, const size_t amount, const size_t stride, const int skipped,
+                                       IntAggregates* aggregates);
+
+__attribute__((target("avx2")))
+static inline __m256i GetLanesAvx2(const int lanes);
+__attribute__((target("avx2")))
+static inline void    AggregateVectorAvx2(const int* ints, const __m256i lanes, const __m256i skipped,
+                                          Avx2Aggregates* vec_aggregates);
+__attribute__((target("avx2")))
+static void           AggregateIntsAvx2(const int* data, const size_t amount, const size_t stride, const int skipped,
+                                        IntAggregates* aggregates);
+
+// lanes of elements in three vectors, which hold {data, next, prev} of 4 (SSE) or 8 (AVX2) elements
+static const int SSE_AOS_LANES[]  = {0b1001, 0b0100, 0b0010};
+static const int AVX2_AOS_LANES[] = {0b01001001, 0b10010010, 0b00100100};
+
+#endif
+
+//-----------------------------------------------------------------------------------------------------
+
+size_t FindIntValue(const int* data, const size_t amount, const size_t stride, const int value)
+{
+    assert(data);
+    assert(stride == SOA_INT_STRIDE || stride == AOS_INT_STRIDE);
+
+#if LIST_SIMD_X86
+    if (HasAvx2())
+        return FindIntValueAvx2(data, amount, stride, value);
+
+    return FindIntValueSse(data, amount, stride, value);
+#else
+    return FindIntValueScalar(data, amount, stride, value);
+#endif
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+size_t CountIntValue(const int* data, const size_t amount, const size_t stride, const int value)
+{
+    assert(data);
+    assert(stride == SOA_INT_STRIDE || stride == AOS_INT_STRIDE);
+
+#if LIST_SIMD_X86
+    if (HasAvx2())
+        return CountIntValueAvx2(data, amount, stride, value);
+
+    return CountIntValueSse(data, amount, stride, value);
+#else
+    return CountIntValueScalar(data, amount, stride, value);
+#endif
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+void AggregateInts(const int* data, const size_t amount, const size_t stride, const int skipped,
+                   IntAggregates* aggregates)
+{
+    assert(data);
+    assert(aggregates);
+    assert(stride == SOA_INT_STRIDE || stride == AOS_INT_STRIDE);
+
+#if LIST_SIMD_X86
+    if (HasAvx2())
+        AggregateIntsAvx2(data, amount, stride, skipped, aggregates);
+    else
+        AggregateIntsSse(data, amount, stride, skipped, aggregates);
+#else
+    AggregateIntsScalar(data, amount, stride, skipped, aggregates);
+#endif
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+void MergeIntAggregates(IntAggregates* aggregates, const IntAggregates* other)
+{
+    assert(aggregates);
+    assert(other);
+
+    aggregates->sum   += other->sum;
+    aggregates->count += other->count;
+
+    if (other->min < aggregates->min)
+        aggregates->min = other->min;
+    if (other->max > aggregates->max)
+        aggregates->max = other->max;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+void CountIntHistogram(const int* data, const size_t amount, const size_t stride, const int skipped,
+                       IntHistogram* histogram)
+{
+    assert(data);
+    assert(histogram);
+    assert(histogram->counts);
+    assert(histogram->bucket_width > 0);
+
+    for (size_t i = 0; i < amount; i++)
+    {
+        int value = data[i * stride];
+        if (value == skipped || value < histogram->min_value)
+            continue;
+
+        //          v------ difference of two ints does not fit in int
+        long long offset = (long long) value - histogram->min_value;
+        size_t    bucket = (size_t) (offset / histogram->bucket_width);
+
+        if (bucket < histogram->buckets)
+            histogram->counts[bucket]++;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static size_t FindIntValueScalar(const int* data, const size_t amount, const size_t stride, const int value)
+{
+    assert(data);
+
+    for (size_t i = 0; i < amount; i++)
+    {
+        if (data[i * stride] == value)
+            return i;
+    }
+
+    return amount;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static size_t CountIntValueScalar(const int* data, const size_t amount, const size_t stride, const int value)
+{
+    assert(data);
+
+    size_t count = 0;
+
+    for (size_t i = 0; i < amount; i++)
+        count += (data[i * stride] == value);
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void AggregateIntsScalar(const int* data, const size_t amount, const size_t stride, const int skipped,
+                                IntAggregates* aggregates)
+{
+    assert(data);
+    assert(aggregates);
+
+    for (size_t i = 0; i < amount; i++)
+    {
+        int value = data[i * stride];
+        if (value == skipped)
+            continue;
+
+        aggregates->sum += value;
+        aggregates->count++;
+
+        if (value < aggregates->min)
+            aggregates->min = value;
+        if (value > aggregates->max)
+            aggregates->max = value;
+    }
+}
+
+#if LIST_SIMD_X86
+
+//-----------------------------------------------------------------------------------------------------
+
+static bool HasAvx2()
+{
+    static const bool HAS_AVX2 = __builtin_cpu_supports("avx2");
+
+    return HAS_AVX2;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static inline unsigned MatchIntsSse(const int* ints, const __m128i value, const int lanes)
+{
+    __m128i loaded  = _mm_loadu_si128((const __m128i*) ints);
+    int     matched = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(loaded, value)));
+
+    return (unsigned) (matched & lanes);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static size_t FindIntValueSse(const int* data, const size_t amount, const size_t stride, const int value)
+{
+    assert(data);
+
+    __m128i values = _mm_set1_epi32(value);
+    size_t  i      = 0;
+
+    // block of SSE_INTS elements takes stride vectors, every matched int lane is one bit
+    for (; i + SSE_INTS <= amount; i += SSE_INTS)
+    {
+        const int* block   = data + i * stride;
+        unsigned   matched = 0;
+
+        if (stride == SOA_INT_STRIDE)
+        {
+            matched = MatchIntsSse(block, values, 0b1111);
+        }
+        else
+        {
+            for (size_t vec = 0; vec < AOS_INT_STRIDE; vec++)
+                matched |= MatchIntsSse(block + vec * SSE_INTS, values, SSE_AOS_LANES[vec]) << (vec * SSE_INTS);
+        }
+
+        if (matched)
+            return i + (size_t) __builtin_ctz(matched) / stride;
+    }
+
+    size_t found = FindIntValueScalar(data + i * stride, amount - i, stride, value);
+
+    return i + found;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static size_t CountIntValueSse(const int* data, const size_t amount, const size_t stride, const int value)
+{
+    assert(data);
+
+    __m128i values = _mm_set1_epi32(value);
+    size_t  count  = 0;
+    size_t  i      = 0;
+
+    for (; i + SSE_INTS <= amount; i += SSE_INTS)
+    {
+        const int* block = data + i * stride;
+
+        if (stride == SOA_INT_STRIDE)
+        {
+            count += (size_t) __builtin_popcount(MatchIntsSse(block, values, 0b1111));
+        }
+        else
+        {
+            for (size_t vec = 0; vec < AOS_INT_STRIDE; vec++)
+                count += (size_t) __builtin_popcount(MatchIntsSse(block + vec * SSE_INTS, values, SSE_AOS_LANES[vec]));
+        }
+    }
+
+    return count + CountIntValueScalar(data + i * stride, amount - i, stride, value);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+static inline unsigned MatchIntsAvx2(const int* ints, const __m256i value, const int lanes)
+{
+    __m256i loaded  = _mm256_loadu_si256((const __m256i*) ints);
+    int     matched = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(loaded, value)));
+
+    return (unsigned) (matched & lanes);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+static size_t FindIntValueAvx2(const int* data, const size_t amount, const size_t stride, const int value)
+{
+    assert(data);
+
+    __m256i values = _mm256_set1_epi32(value);
+    size_t  i      = 0;
+
+    for (; i + AVX2_INTS <= amount; i += AVX2_INTS)
+    {
+        const int* block   = data + i * stride;
+        unsigned   matched = 0;
+
+        if (stride == SOA_INT_STRIDE)
+        {
+            matched = MatchIntsAvx2(block, values, 0xFF);
+        }
+        else
+        {
+            for (size_t vec = 0; vec < AOS_INT_STRIDE; vec++)
+                matched |= MatchIntsAvx2(block + vec * AVX2_INTS, values, AVX2_AOS_LANES[vec]) << (vec * AVX2_INTS);
+        }
+
+        if (matched)
+            return i + (size_t) __builtin_ctz(matched) / stride;
+    }
+
+    // tail is shorter than one vector, SSE kernel finishes it
+    return i + FindIntValueSse(data + i * stride, amount - i, stride, value);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+static size_t CountIntValueAvx2(const int* data, const size_t amount, const size_t stride, const int value)
+{
+    assert(data);
+
+    __m256i values = _mm256_set1_epi32(value);
+    size_t  count  = 0;
+    size_t  i      = 0;
+
+    for (; i + AVX2_INTS <= amount; i += AVX2_INTS)
+    {
+        const int* block = data + i * stride;
+
+        if (stride == SOA_INT_STRIDE)
+        {
+            count += (size_t) __builtin_popcount(MatchIntsAvx2(block, values, 0xFF));
+        }
+        else
+        {
+            for (size_t vec = 0; vec < AOS_INT_STRIDE; vec++)
+                count += (size_t) __builtin_popcount(MatchIntsAvx2(block + vec * AVX2_INTS, values, AVX2_AOS_LANES[vec]));
+        }
+    }
+
+    return count + CountIntValueSse(data + i * stride, amount - i, stride, value);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static inline __m128i GetLanesSse(const int lanes)
+{
+    return _mm_set_epi32((lanes & 8) ? -1 : 0, (lanes & 4) ? -1 : 0, (lanes & 2) ? -1 : 0, (lanes & 1) ? -1 : 0);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static inline void AggregateVectorSse(const int* ints, const __m128i lanes, const __m128i skipped,
+                                      SseAggregates* vec_aggregates)
+{
+    __m128i loaded = _mm_loadu_si128((const __m128i*) ints);
+    __m128i valid  = _mm_andnot_si128(_mm_cmpeq_epi32(loaded, skipped), lanes);
+
+    vec_aggregates->count += (size_t) __builtin_popcount((unsigned) _mm_movemask_ps(_mm_castsi128_ps(valid)));
+
+    // SSE2 has neither sign extension nor blend, so they are made by shifts and masks
+    __m128i masked = _mm_and_si128(loaded, valid);
+    __m128i sign   = _mm_srai_epi32(masked, 31);
+
+    vec_aggregates->sum = _mm_add_epi64(vec_aggregates->sum, _mm_unpacklo_epi32(masked, sign));
+    vec_aggregates->sum = _mm_add_epi64(vec_aggregates->sum, _mm_unpackhi_epi32(masked, sign));
+
+    __m128i min_candidate = _mm_or_si128(masked, _mm_andnot_si128(valid, _mm_set1_epi32(INT_MAX)));
+    __m128i less          = _mm_cmplt_epi32(min_candidate, vec_aggregates->min);
+
+    vec_aggregates->min = _mm_or_si128(_mm_and_si128(less, min_candidate), _mm_andnot_si128(less, vec_aggregates->min));
+
+    __m128i max_candidate = _mm_or_si128(masked, _mm_andnot_si128(valid, _mm_set1_epi32(INT_MIN)));
+    __m128i greater       = _mm_cmpgt_epi32(max_candidate, vec_aggregates->max);
+
+    vec_aggregates->max = _mm_or_si128(_mm_and_si128(greater, max_candidate),
+                                       _mm_andnot_si128(greater, vec_aggregates->max));
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void AggregateIntsSse(const int* data, const size_t amount, const size_t stride, const int skipped,
+                             IntAggregates* aggregates)
+{
+    assert(data);
+    assert(aggregates);
+
+    SseAggregates vec_aggregates = {_mm_setzero_si128(), _mm_set1_epi32(INT_MAX), _mm_set1_epi32(INT_MIN), 0};
+
+    __m128i skipped_values = _mm_set1_epi32(skipped);
+    __m128i lanes[AOS_INT_STRIDE] = {};
+
+    for (size_t vec = 0; vec < AOS_INT_STRIDE; vec++)
+        lanes[vec] = (stride == SOA_INT_STRIDE) ? GetLanesSse(0b1111) : GetLanesSse(SSE_AOS_LANES[vec]);
+
+    size_t i = 0;
+
+    for (; i + SSE_INTS <= amount; i += SSE_INTS)
+    {
+        const int* block = data + i * stride;
+
+        for (size_t vec = 0; vec < stride; vec++)
+            AggregateVectorSse(block + vec * SSE_INTS, lanes[vec], skipped_values, &vec_aggregates);
+    }
+
+    alignas(16) long long sums[2] = {};
+    alignas(16) int       mins[SSE_INTS] = {};
+    alignas(16) int       maxs[SSE_INTS] = {};
+
+    _mm_store_si128((__m128i*) sums, vec_aggregates.sum);
+    _mm_store_si128((__m128i*) mins, vec_aggregates.min);
+    _mm_store_si128((__m128i*) maxs, vec_aggregates.max);
+
+    IntAggregates block_aggregates = {sums[0] + sums[1], INT_MAX, INT_MIN, vec_aggregates.count};
+
+    for (size_t lane = 0; lane < SSE_INTS; lane++)
+    {
+        if (mins[lane] < block_aggregates.min) block_aggregates.min = mins[lane];
+        if (maxs[lane] > block_aggregates.max) block_aggregates.max = maxs[lane];
+    }
+
+    MergeIntAggregates(aggregates, &block_aggregates);
+
+    AggregateIntsScalar(data + i * stride, amount - i, stride, skipped, aggregates);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+static inline __m256i GetLanesAvx2(const int lanes)
+{
+    __m256i bits = _mm256_set_epi32(128, 64, 32, 16, 8, 4, 2, 1);
+
+    return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(lanes), bits), bits);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+static inline void AggregateVectorAvx2(const int* ints, const __m256i lanes, const __m256i skipped,
+                                       Avx2Aggregates* vec_aggregates)
+{
+    __m256i loaded = _mm256_loadu_si256((const __m256i*) ints);
+    __m256i valid  = _mm256_andnot_si256(_mm256_cmpeq_epi32(loaded, skipped), lanes);
+
+    vec_aggregates->count += (size_t) __builtin_popcount((unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(valid)));
+
+    __m256i masked = _mm256_and_si256(loaded, valid);
+
+    vec_aggregates->sum = _mm256_add_epi64(vec_aggregates->sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(masked)));
+    vec_aggregates->sum = _mm256_add_epi64(vec_aggregates->sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(masked, 1)));
+
+    vec_aggregates->min = _mm256_min_epi32(vec_aggregates->min,
+                                           _mm256_blendv_epi8(_mm256_set1_epi32(INT_MAX), loaded, valid));
+    vec_aggregates->max = _mm256_max_epi32(vec_aggregates->max,
+                                           _mm256_blendv_epi8(_mm256_set1_epi32(INT_MIN), loaded, valid));
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+static void AggregateIntsAvx2(const int* data, const size_t amount, const size_t stride, const int skipped,
+                              IntAggregates* aggregates)
+{
+    assert(data);
+    assert(aggregates);
+
+    Avx2Aggregates vec_aggregates = {_mm256_setzero_si256(), _mm256_set1_epi32(INT_MAX),
+                                     _mm256_set1_epi32(INT_MIN), 0};
+
+    __m256i skipped_values = _mm256_set1_epi32(skipped);
+    __m256i lanes[AOS_INT_STRIDE] = {};
+
+    for (size_t vec = 0; vec < AOS_INT_STRIDE; vec++)
+        lanes[vec] = (stride == SOA_INT_STRIDE) ? GetLanesAvx2(0xFF) : GetLanesAvx2(AVX2_AOS_LANES[vec]);
+
+    size_t i = 0;
+
+    for (; i + AVX2_INTS <= amount; i += AVX2_INTS)
+    {
+        const int* block = data + i * stride;
+
+        for (size_t vec = 0; vec < stride; vec++)
+            AggregateVectorAvx2(block + vec * AVX2_INTS, lanes[vec], skipped_values, &vec_aggregates);
+    }
+
+    alignas(32) long long sums[4] = {};
+    alignas(32) int       mins[AVX2_INTS] = {};
+    alignas(32) int       maxs[AVX2_INTS] = {};
+
+    _mm256_store_si256((__m256i*) sums, vec_aggregates.sum);
+    _mm256_store_si256((__m256i*) mins, vec_aggregates.min);
+    _mm256_store_si256((__m256i*) maxs, vec_aggregates.max);
+
+    IntAggregates block_aggregates = {sums[0] + sums[1] + sums[2] + sums[3], INT_MAX, INT_MIN, vec_aggregates.count};
+
+    for (size_t lane = 0; lane < AVX2_INTS; lane++)
+    {
+        if (mins[lane] < block_aggregates.min) block_aggregates.min = mins[lane];
+        if (maxs[lane] > block_aggregates.max) block_aggregates.max = maxs[lane];
+    }
+
+    MergeIntAggregates(aggregates, &block_aggregates);
+
+    // tail is shorter than one vector, SSE kernel finishes it
+    AggregateIntsSse(data + i * stride, amount - i, stride, skipped, aggregates);
+}
+
+#endif
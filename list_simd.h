@@ -0,0 +1,95 @@
+#ifndef __LIST_SIMD_H_
+#define __LIST_SIMD_H_
+
+/*! \file
+* \brief Contains vectorized scans of int elements, which are placed in memory with constant stride
+*/
+
+#include <stddef.h>
+#include <limits.h>
+
+static const size_t AOS_INT_STRIDE = 3;     ///< ints in one {data, next, prev} element
+static const size_t SOA_INT_STRIDE = 1;
+
+/// order independent aggregates of int elements
+struct IntAggregates
+{
+    long long sum;
+    int       min;      ///< INT_MAX if there are no elements
+    int       max;      ///< INT_MIN if there are no elements
+    size_t    count;
+};
+
+/// buckets of histogram: [min_value + i * bucket_width, min_value + (i + 1) * bucket_width)
+struct IntHistogram
+{
+    int     min_value;
+    int     bucket_width;
+    size_t  buckets;
+    size_t* counts;     ///< values out of buckets are not counted
+};
+
+inline void InitIntAggregates(IntAggregates* aggregates)
+{
+    *aggregates = {0, INT_MAX, INT_MIN, 0};
+}
+
+/************************************************************//**
+ * @brief Finds first element with value, uses AVX2 if processor
+ * has it, SSE2 or plain loop otherwise
+ *
+ * @param[in] data first element
+ * @param[in] amount amount of elements
+ * @param[in] stride distance between elements in ints (1 or 3)
+ * @param[in] value searched value
+ * @return size_t number of found element, amount if there is no such element
+ ************************************************************/
+size_t FindIntValue(const int* data, const size_t amount, const size_t stride, const int value);
+
+/************************************************************//**
+ * @brief Counts elements with value, uses AVX2 if processor
+ * has it, SSE2 or plain loop otherwise
+ *
+ * @param[in] data first element
+ * @param[in] amount amount of elements
+ * @param[in] stride distance between elements in ints (1 or 3)
+ * @param[in] value counted value
+ * @return size_t amount of elements with value
+ ************************************************************/
+size_t CountIntValue(const int* data, const size_t amount, const size_t stride, const int value);
+
+/************************************************************//**
+ * @brief Adds elements to aggregates, uses AVX2 if processor
+ * has it, SSE2 or plain loop otherwise
+ *
+ * @param[in] data first element
+ * @param[in] amount amount of elements
+ * @param[in] stride distance between elements in ints (1 or 3)
+ * @param[in] skipped elements with this value are not aggregated
+ * @param[out] aggregates aggregates, which are updated
+ ************************************************************/
+void AggregateInts(const int* data, const size_t amount, const size_t stride, const int skipped,
+                   IntAggregates* aggregates);
+
+/************************************************************//**
+ * @brief Adds two aggregates
+ *
+ * @param[out] aggregates aggregates, which are updated
+ * @param[in] other added aggregates
+ ************************************************************/
+void MergeIntAggregates(IntAggregates* aggregates, const IntAggregates* other);
+
+/************************************************************//**
+ * @brief Adds elements to histogram, it is not vectorized:
+ * increments of one bucket by neighbour lanes conflict
+ *
+ * @param[in] data first element
+ * @param[in] amount amount of elements
+ * @param[in] stride distance between elements in ints (1 or 3)
+ * @param[in] skipped elements with this value are not counted
+ * @param[out] histogram histogram, which counts are updated
+ ************************************************************/
+void CountIntHistogram(const int* data, const size_t amount, const size_t stride, const int skipped,
+                       IntHistogram* histogram);
+
+#endif
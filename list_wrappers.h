@@ -0,0 +1,294 @@
+#ifndef __LIST_WRAPPERS_H_
+#define __LIST_WRAPPERS_H_
+
+/*! \file
+* \brief Contains owning wrappers of fast and pointer lists with iterators, they only forward calls to C API
+*/
+
+#include <stddef.h>
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "fast_list.h"
+#include "ptr_list.h"
+
+/// walks links of fast list, end is fictive element, so --end() is the tail
+template <class ListT, bool is_const>
+class ListIterator
+{
+    public:
+        typedef std::bidirectional_iterator_tag                                     iterator_category;
+        typedef typename ListT::data_t                                              value_type;
+        typedef ptrdiff_t                                                           difference_type;
+        typedef typename std::conditional<is_const, const value_type*, value_type*>::type pointer;
+        typedef typename std::conditional<is_const, const value_type&, value_type&>::type reference;
+
+        typedef typename std::conditional<is_const, const ListT*, ListT*>::type     list_ptr_t;
+
+        ListIterator() : list_(nullptr), pos_(FICTIVE_ELEM_POS) {}
+        ListIterator(list_ptr_t list, const size_t pos) : list_(list), pos_(pos) {}
+
+        /// iterator can be made const, not vice versa
+        template <bool other_const, typename = typename std::enable_if<is_const && !other_const>::type>
+        ListIterator(const ListIterator<ListT, other_const>& other) : list_(other.List()), pos_(other.Pos()) {}
+
+        reference operator*()  const { return  ListData(list_, pos_); }
+        pointer   operator->() const { return &ListData(list_, pos_); }
+
+        ListIterator& operator++()    { pos_ = (size_t) ListNext(list_, pos_); return *this; }
+        ListIterator& operator--()    { pos_ = (size_t) ListPrev(list_, pos_); return *this; }
+        ListIterator  operator++(int) { ListIterator old = *this; ++*this; return old; }
+        ListIterator  operator--(int) { ListIterator old = *this; --*this; return old; }
+
+        bool operator==(const ListIterator& other) const { return pos_ == other.pos_ && list_ == other.list_; }
+        bool operator!=(const ListIterator& other) const { return !(*this == other); }
+
+        /// slot of element, it is passed to C API
+        size_t     Pos()  const { return pos_; }
+        list_ptr_t List() const { return list_; }
+
+    private:
+        list_ptr_t list_;
+        size_t     pos_;
+};
+
+/// owns fast list: move steals its arrays, copy is forbidden, errors of the last call are kept inside
+template <class ListT = list_t>
+class ListWrapper
+{
+    public:
+        typedef typename ListT::data_t        data_t;
+        typedef ListIterator<ListT, false>    iterator;
+        typedef ListIterator<ListT, true>     const_iterator;
+
+        /// result of construction is in GetError(), list without storage can be only destroyed or assigned
+        explicit ListWrapper(const size_t capacity = DEFAULT_LIST_CAPACITY) : list_(), error_()
+        {
+            ListCtor(&list_, &error_, capacity);
+        }
+
+        ~ListWrapper() { Destroy(); }
+
+        ListWrapper(const ListWrapper&)            = delete;
+        ListWrapper& operator=(const ListWrapper&) = delete;
+
+        ListWrapper(ListWrapper&& other) noexcept : list_(other.list_), error_(other.error_)
+        {
+            other.list_ = {};
+        }
+
+        ListWrapper& operator=(ListWrapper&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Destroy();
+
+                list_        = other.list_;
+                error_       = other.error_;
+                other.list_  = {};
+            }
+
+            return *this;
+        }
+
+        /// list itself for the rest of C API
+        ListT*       Get()       { return &list_; }
+        const ListT* Get() const { return &list_; }
+
+        const ErrorInfo* GetError() const { return &error_; }
+
+        size_t Size()  const { return list_.size; }
+        bool   Empty() const { return list_.size == 0; }
+
+        ListErrors PushBack(data_t value)  { return InsertBefore(FICTIVE_ELEM_POS, std::move(value)); }
+        ListErrors PushFront(data_t value) { return InsertAfter(FICTIVE_ELEM_POS, std::move(value)); }
+
+        ListErrors InsertAfter(const size_t pos, data_t value, size_t* inserted_pos = nullptr)
+        {
+            size_t new_pos = FICTIVE_ELEM_POS;
+            error_         = {};
+
+            ListErrors list_err = ListInsertAfterElem(&list_, pos, std::move(value), &new_pos, &error_);
+            if (inserted_pos)
+                *inserted_pos = new_pos;
+
+            return list_err;
+        }
+
+        ListErrors InsertBefore(const size_t pos, data_t value, size_t* inserted_pos = nullptr)
+        {
+            size_t new_pos = FICTIVE_ELEM_POS;
+            error_         = {};
+
+            ListErrors list_err = ListInsertBeforeElem(&list_, pos, std::move(value), &new_pos, &error_);
+            if (inserted_pos)
+                *inserted_pos = new_pos;
+
+            return list_err;
+        }
+
+        ListErrors Remove(const size_t pos)
+        {
+            error_ = {};
+
+            return ListRemoveElem(&list_, pos, &error_);
+        }
+
+        iterator       begin()        { return iterator(&list_, (size_t) GetListHead(&list_)); }
+        iterator       end()          { return iterator(&list_, FICTIVE_ELEM_POS); }
+        const_iterator begin()  const { return const_iterator(&list_, (size_t) GetListHead(&list_)); }
+        const_iterator end()    const { return const_iterator(&list_, FICTIVE_ELEM_POS); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend()   const { return end(); }
+
+    private:
+        /// moved out and not constructed lists have no storage
+        void Destroy()
+        {
+            if (list_.capacity != 0)
+                ListDtor(&list_);
+        }
+
+        ListT     list_;
+        ErrorInfo error_;
+};
+
+/// walks links of pointer list, end is fictive element
+template <bool is_const>
+class PtrListIterator
+{
+    public:
+        typedef std::bidirectional_iterator_tag                                 iterator_category;
+        typedef int                                                             value_type;
+        typedef ptrdiff_t                                                       difference_type;
+        typedef typename std::conditional<is_const, const int*, int*>::type    pointer;
+        typedef typename std::conditional<is_const, const int&, int&>::type    reference;
+
+        PtrListIterator() : elem_(nullptr) {}
+        explicit PtrListIterator(PtrListElem* elem) : elem_(elem) {}
+
+        /// iterator can be made const, not vice versa
+        template <bool other_const, typename = typename std::enable_if<is_const && !other_const>::type>
+        PtrListIterator(const PtrListIterator<other_const>& other) : elem_(other.Pos()) {}
+
+        reference operator*()  const { return  elem_->data; }
+        pointer   operator->() const { return &elem_->data; }
+
+        PtrListIterator& operator++()    { elem_ = elem_->next; return *this; }
+        PtrListIterator& operator--()    { elem_ = elem_->prev; return *this; }
+        PtrListIterator  operator++(int) { PtrListIterator old = *this; ++*this; return old; }
+        PtrListIterator  operator--(int) { PtrListIterator old = *this; --*this; return old; }
+
+        bool operator==(const PtrListIterator& other) const { return elem_ == other.elem_; }
+        bool operator!=(const PtrListIterator& other) const { return elem_ != other.elem_; }
+
+        /// element, it is passed to C API
+        PtrListElem* Pos() const { return elem_; }
+
+    private:
+        PtrListElem* elem_;
+};
+
+/// owns pointer list: move steals its pool, copy is forbidden, errors of the last call are kept inside
+class PtrListWrapper
+{
+    public:
+        typedef int                     data_t;
+        typedef PtrListIterator<false>  iterator;
+        typedef PtrListIterator<true>   const_iterator;
+
+        /// result of construction is in GetError(), list without fictive element can be only destroyed or assigned
+        PtrListWrapper() : list_(), error_()
+        {
+            PtrListCtor(&list_, &error_);
+        }
+
+        ~PtrListWrapper() { Destroy(); }
+
+        PtrListWrapper(const PtrListWrapper&)            = delete;
+        PtrListWrapper& operator=(const PtrListWrapper&) = delete;
+
+        PtrListWrapper(PtrListWrapper&& other) noexcept : list_(other.list_), error_(other.error_)
+        {
+            other.list_ = {};
+        }
+
+        PtrListWrapper& operator=(PtrListWrapper&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Destroy();
+
+                list_        = other.list_;
+                error_       = other.error_;
+                other.list_  = {};
+            }
+
+            return *this;
+        }
+
+        /// list itself for the rest of C API
+        ptrlist_t*       Get()       { return &list_; }
+        const ptrlist_t* Get() const { return &list_; }
+
+        const ErrorInfo* GetError() const { return &error_; }
+
+        size_t Size()  const { return list_.size; }
+        bool   Empty() const { return list_.size == 0; }
+
+        PtrListErrors PushBack(const int value)  { return InsertBefore(list_.fictive, value); }
+        PtrListErrors PushFront(const int value) { return InsertAfter(list_.fictive, value); }
+
+        PtrListErrors InsertAfter(PtrListElem* pos, const int value, PtrListElem** inserted_pos = nullptr)
+        {
+            PtrListElem* new_pos = nullptr;
+            error_               = {};
+
+            PtrListErrors list_err = PtrListInsertAfterElem(&list_, pos, value, &new_pos, &error_);
+            if (inserted_pos)
+                *inserted_pos = new_pos;
+
+            return list_err;
+        }
+
+        PtrListErrors InsertBefore(PtrListElem* pos, const int value, PtrListElem** inserted_pos = nullptr)
+        {
+            PtrListElem* new_pos = nullptr;
+            error_               = {};
+
+            PtrListErrors list_err = PtrListInsertBeforeElem(&list_, pos, value, &new_pos, &error_);
+            if (inserted_pos)
+                *inserted_pos = new_pos;
+
+            return list_err;
+        }
+
+        PtrListErrors Remove(PtrListElem* pos)
+        {
+            error_ = {};
+
+            return PtrListRemoveElem(&list_, pos, &error_);
+        }
+
+        iterator       begin()        { return iterator(GetPtrListHead(&list_)); }
+        iterator       end()          { return iterator(list_.fictive); }
+        const_iterator begin()  const { return const_iterator(GetPtrListHead(&list_)); }
+        const_iterator end()    const { return const_iterator(list_.fictive); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend()   const { return end(); }
+
+    private:
+        /// moved out and not constructed lists have no fictive element
+        void Destroy()
+        {
+            if (list_.fictive != nullptr)
+                PtrListDtor(&list_);
+        }
+
+        ptrlist_t list_;
+        ErrorInfo error_;
+};
+
+#endif
@@ -1,24 +1,106 @@
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <assert.h>
 #include <stdarg.h>
 #include <strings.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include "logs.h"
 
 static FILE* __LOG_STREAM__ = stderr;
 
+/// descriptor of log stream, abort handler writes in it without stdio
+static volatile sig_atomic_t LOG_FD = STDERR_FILENO;
+
 static const char* EXTENSION = ".log.html";
 
+/// piece of log text, its text goes right after it
+struct LogChunk
+{
+    LogChunk* next;
+
+    size_t length;
+    size_t capacity;
+};
+
+/// log stream of one thread, its full buffer is given to flusher as one chunk,
+/// flusher also takes lines from partial buffer periodically
+struct LogThreadBuffer
+{
+    FILE*            stream;
+    LogChunk*        tail;     ///< text after the last line end, it waits for the rest of its line
+    LogThreadBuffer* next;     ///< next registered buffer
+
+    LogThreadBuffer() : stream(nullptr), tail(nullptr), next(nullptr) {}
+    ~LogThreadBuffer();
+
+    LogThreadBuffer(const LogThreadBuffer&)             = delete;
+    LogThreadBuffer& operator=(const LogThreadBuffer&)  = delete;
+};
+
+static thread_local LogThreadBuffer THREAD_LOG;
+static thread_local bool            THREAD_LOG_DESTROYED = false;
+
+// buffers of all threads, which have log stream, they are drained without their threads
+
+static std::mutex       REGISTRY_LOCK;
+static LogThreadBuffer* FIRST_BUFFER = nullptr;
+
+/// set when program is aborted, chunks are written right away and are not queued any more
+static std::atomic<bool> ABORTING(false);
+
+// background flusher, which writes chunks in log file
+
+static std::mutex              FLUSHER_LOCK;
+static std::condition_variable CHUNK_SUBMITTED;
+static std::condition_variable CHUNKS_WRITTEN;
+static std::thread             FLUSHER_THREAD;
+
+static LogChunk* FIRST_CHUNK      = nullptr;
+static LogChunk* LAST_CHUNK       = nullptr;
+
+static bool      FLUSHER_STARTED  = false;
+static bool      FLUSHER_STOPPED  = false;
+static bool      WRITING          = false;
+
+static LogChunk* AllocLogChunk(const size_t capacity);
+static char*     GetChunkText(LogChunk* chunk);
+static void      SubmitLogChunk(LogChunk* chunk);
+static void      WriteLogChunks(LogChunk* chunks);
+static void      WaitLogChunks();
+static void      DrainLogBuffer(LogThreadBuffer* buffer, const bool with_tail);
+static void      DrainLogBuffers(const bool with_tails);
+static void      UnregisterLogBuffer(LogThreadBuffer* buffer);
+static void      DrainLogOnAbort(int signal_code);
+static void      WriteLogFd(const char* text, size_t length);
+static void      WriteStreamBufferFd(const FILE* stream);
+static void      StartLogFlusher();
+static void      AppendToLogTail(LogThreadBuffer* buffer, const char* text, const size_t length);
+static void      RunLogFlusher();
+static void      StopLogFlusher();
+static FILE*     GetThreadLogStream();
+static ssize_t   WriteLogStream(void* cookie, const char* text, size_t length);
+
 void OpenLogFile(const char* FILE_NAME)
 {
-    char* file_name = strndup(FILE_NAME, MAX_FILE_NAME_LEN);
+    char file_name[MAX_FILE_NAME_LEN + sizeof(".log.html")] = {};
+    snprintf(file_name, sizeof(file_name), "%.*s%s", (int) MAX_FILE_NAME_LEN, FILE_NAME, EXTENSION);
 
-    __LOG_STREAM__ = fopen(strncat(file_name, EXTENSION, MAX_FILE_NAME_LEN + sizeof(EXTENSION)), "a");
+    __LOG_STREAM__ = fopen(file_name, "a");
 
     if (__LOG_STREAM__ == nullptr)
         __LOG_STREAM__ =  stderr;
 
+    LOG_FD = fileno(__LOG_STREAM__);
+
     time_t now = 0;
     time(&now);
 
@@ -40,17 +122,38 @@ void OpenLogFile(const char* FILE_NAME)
     fprintf(__LOG_STREAM__, "<br>\n");
 
     atexit(CloseLogFile);
-    free(file_name);
+    signal(SIGABRT, DrainLogOnAbort);
 }
 
 //-----------------------------------------------------------------------------------------------------
 
 void CloseLogFile()
 {
+    // nothing is written after footer, so unfinished lines of all threads are taken too
+    DrainLogBuffers(true);
+    WaitLogChunks();
+    StopLogFlusher();
+
     fprintf(__LOG_STREAM__, "******************************************************************************<br>\n"
                             "============================ PROGRAM END ============================<br>\n"
                             "******************************************************************************<br>\n");
+    LOG_FD = STDERR_FILENO;
     fclose(__LOG_STREAM__);
+
+    __LOG_STREAM__ = stderr;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+void FlushLog()
+{
+    // other threads can continue their unfinished lines, so only lines of current thread are cut
+    DrainLogBuffers(false);
+
+    if (!THREAD_LOG_DESTROYED && THREAD_LOG.stream != nullptr)
+        DrainLogBuffer(&THREAD_LOG, true);
+
+    WaitLogChunks();
 }
 
 //-----------------------------------------------------------------------------------------------------
@@ -60,7 +163,8 @@ int LogDump(dump_f dump_func, const void* stk, const char* func, const char* fil
     assert(dump_func);
     assert(stk);
 
-    return dump_func(__LOG_STREAM__, stk, func, file, line);
+    // dump functions mix fprintf and PrintLog, so they write in the same stream
+    return dump_func(GetThreadLogStream(), stk, func, file, line);
 }
 
 //-----------------------------------------------------------------------------------------------------
@@ -71,9 +175,403 @@ int PrintLog (const char *format, ...)
   int done;
 
   va_start (arg, format);
-  done = vfprintf(__LOG_STREAM__, format, arg);
+  done = vfprintf(GetThreadLogStream(), format, arg);
   va_end (arg);
 
   return done;
 }
 
+//-----------------------------------------------------------------------------------------------------
+
+LogThreadBuffer::~LogThreadBuffer()
+{
+    // closing flushes the rest of buffer to flusher
+    if (stream != nullptr)
+    {
+        UnregisterLogBuffer(this);
+        fclose(stream);
+    }
+
+    SubmitLogChunk(tail);
+
+    stream               = nullptr;
+    tail                 = nullptr;
+    THREAD_LOG_DESTROYED = true;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static LogChunk* AllocLogChunk(const size_t capacity)
+{
+    LogChunk* chunk = (LogChunk*) malloc(sizeof(LogChunk) + capacity);
+    if (chunk == nullptr)
+        return nullptr;
+
+    chunk->next     = nullptr;
+    chunk->length   = 0;
+    chunk->capacity = capacity;
+
+    return chunk;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static char* GetChunkText(LogChunk* chunk)
+{
+    assert(chunk);
+
+    return (char*) (chunk + 1);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void SubmitLogChunk(LogChunk* chunk)
+{
+    if (chunk == nullptr)
+        return;
+
+    if (ABORTING.load(std::memory_order_acquire))
+    {
+        WriteLogChunks(chunk);
+        return;
+    }
+
+    std::unique_lock<std::mutex> guard(FLUSHER_LOCK);
+
+    // log file is already closed or program shuts down, so chunk is written right now
+    if (FLUSHER_STOPPED)
+    {
+        WriteLogChunks(chunk);
+        return;
+    }
+
+    if (LAST_CHUNK == nullptr)
+        FIRST_CHUNK      = chunk;
+    else
+        LAST_CHUNK->next = chunk;
+
+    LAST_CHUNK = chunk;
+
+    StartLogFlusher();
+
+    guard.unlock();
+    CHUNK_SUBMITTED.notify_one();
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void WriteLogChunks(LogChunk* chunks)
+{
+    while (chunks != nullptr)
+    {
+        LogChunk* next = chunks->next;
+
+        fwrite(GetChunkText(chunks), sizeof(char), chunks->length, __LOG_STREAM__);
+        free(chunks);
+
+        chunks = next;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void WaitLogChunks()
+{
+    std::unique_lock<std::mutex> guard(FLUSHER_LOCK);
+
+    CHUNKS_WRITTEN.wait(guard, [] { return FIRST_CHUNK == nullptr && !WRITING; });
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void DrainLogBuffer(LogThreadBuffer* buffer, const bool with_tail)
+{
+    assert(buffer);
+    assert(buffer->stream);
+
+    // owner thread writes in the same stream, its lock also guards tail
+    flockfile(buffer->stream);
+
+    fflush_unlocked(buffer->stream);
+
+    // cut line is ended, so text of other threads never continues it
+    if (with_tail && buffer->tail != nullptr)
+    {
+        AppendToLogTail(buffer, "\n", 1);
+
+        SubmitLogChunk(buffer->tail);
+        buffer->tail = nullptr;
+    }
+
+    funlockfile(buffer->stream);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void DrainLogBuffers(const bool with_tails)
+{
+    // locks are taken in order: registry, stream, flusher
+    std::lock_guard<std::mutex> guard(REGISTRY_LOCK);
+
+    for (LogThreadBuffer* buffer = FIRST_BUFFER; buffer != nullptr; buffer = buffer->next)
+        DrainLogBuffer(buffer, with_tails);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void UnregisterLogBuffer(LogThreadBuffer* buffer)
+{
+    assert(buffer);
+
+    std::lock_guard<std::mutex> guard(REGISTRY_LOCK);
+
+    for (LogThreadBuffer** link = &FIRST_BUFFER; *link != nullptr; link = &(*link)->next)
+    {
+        if (*link == buffer)
+        {
+            *link = buffer->next;
+            break;
+        }
+    }
+
+    buffer->next = nullptr;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void DrainLogOnAbort(int signal_code)
+{
+    // only write(2) is safe in signal handler: nothing is locked, freed or passed to stdio,
+    // lists are read as they are, broken threads can leave them half updated
+    ABORTING.store(true, std::memory_order_release);
+
+    WriteStreamBufferFd(__LOG_STREAM__);
+
+    for (LogChunk* chunk = FIRST_CHUNK; chunk != nullptr; chunk = chunk->next)
+        WriteLogFd(GetChunkText(chunk), chunk->length);
+
+    // tail is older than text in stream buffer
+    for (const LogThreadBuffer* buffer = FIRST_BUFFER; buffer != nullptr; buffer = buffer->next)
+    {
+        if (buffer->tail != nullptr)
+            WriteLogFd(GetChunkText(buffer->tail), buffer->tail->length);
+
+        WriteStreamBufferFd(buffer->stream);
+    }
+
+    signal(signal_code, SIG_DFL);
+    raise(signal_code);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void WriteLogFd(const char* text, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t written = write(LOG_FD, text, length);
+
+        if (written < 0)
+            return;
+
+        text   += written;
+        length -= (size_t) written;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void WriteStreamBufferFd(const FILE* stream)
+{
+    // glibc keeps not flushed text of stream between these pointers
+    if (stream == nullptr || stream->_IO_write_ptr <= stream->_IO_write_base)
+        return;
+
+    WriteLogFd(stream->_IO_write_base, (size_t) (stream->_IO_write_ptr - stream->_IO_write_base));
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void StartLogFlusher()
+{
+    // called under flusher lock
+    if (FLUSHER_STARTED || FLUSHER_STOPPED)
+        return;
+
+    FLUSHER_STARTED = true;
+    FLUSHER_THREAD  = std::thread(RunLogFlusher);
+
+    atexit(StopLogFlusher);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void RunLogFlusher()
+{
+    const std::chrono::milliseconds DRAIN_PERIOD(LOG_FLUSH_PERIOD_MS);
+
+    auto next_drain = std::chrono::steady_clock::now() + DRAIN_PERIOD;
+
+    while (true)
+    {
+        std::unique_lock<std::mutex> guard(FLUSHER_LOCK);
+
+        CHUNK_SUBMITTED.wait_until(guard, next_drain, [] { return FIRST_CHUNK != nullptr || FLUSHER_STOPPED; });
+
+        if (FIRST_CHUNK == nullptr && FLUSHER_STOPPED)
+            return;
+
+        // quiet threads never fill their buffers, so their complete lines are taken from them
+        if (std::chrono::steady_clock::now() >= next_drain)
+        {
+            guard.unlock();
+            DrainLogBuffers(false);
+            guard.lock();
+
+            next_drain = std::chrono::steady_clock::now() + DRAIN_PERIOD;
+        }
+
+        if (FIRST_CHUNK == nullptr)
+            continue;
+
+        LogChunk* chunks = FIRST_CHUNK;
+
+        FIRST_CHUNK = nullptr;
+        LAST_CHUNK  = nullptr;
+        WRITING     = true;
+
+        guard.unlock();
+
+        WriteLogChunks(chunks);
+        fflush(__LOG_STREAM__);
+
+        guard.lock();
+        WRITING = false;
+
+        guard.unlock();
+        CHUNKS_WRITTEN.notify_all();
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void StopLogFlusher()
+{
+    std::unique_lock<std::mutex> guard(FLUSHER_LOCK);
+
+    if (FLUSHER_STOPPED)
+        return;
+
+    FLUSHER_STOPPED = true;
+
+    guard.unlock();
+    CHUNK_SUBMITTED.notify_one();
+
+    // queued chunks are written before flusher stops
+    if (FLUSHER_STARTED)
+        FLUSHER_THREAD.join();
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static FILE* GetThreadLogStream()
+{
+    if (THREAD_LOG_DESTROYED)
+        return __LOG_STREAM__;
+
+    if (THREAD_LOG.stream == nullptr)
+    {
+        cookie_io_functions_t functions = {nullptr, WriteLogStream, nullptr, nullptr};
+
+        THREAD_LOG.stream = fopencookie(&THREAD_LOG, "w", functions);
+        if (THREAD_LOG.stream == nullptr)
+            return __LOG_STREAM__;
+
+        // records are only copied in this buffer, it goes to flusher when it is full or drained
+        setvbuf(THREAD_LOG.stream, nullptr, _IOFBF, LOG_CHUNK_SIZE);
+
+        std::unique_lock<std::mutex> registry_guard(REGISTRY_LOCK);
+
+        THREAD_LOG.next = FIRST_BUFFER;
+        FIRST_BUFFER    = &THREAD_LOG;
+
+        registry_guard.unlock();
+
+        std::lock_guard<std::mutex> flusher_guard(FLUSHER_LOCK);
+        StartLogFlusher();
+    }
+
+    return THREAD_LOG.stream;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static ssize_t WriteLogStream(void* cookie, const char* text, size_t length)
+{
+    assert(cookie);
+
+    LogThreadBuffer* buffer = (LogThreadBuffer*) cookie;
+
+    // chunks of different threads are mixed in file, so they are cut only by line ends
+    size_t lines_len = length;
+    while (lines_len > 0 && text[lines_len - 1] != '\n')
+        lines_len--;
+
+    if (lines_len > 0)
+    {
+        size_t    tail_len = (buffer->tail != nullptr) ? buffer->tail->length : 0;
+        LogChunk* chunk    = AllocLogChunk(tail_len + lines_len);
+
+        if (chunk == nullptr)
+        {
+            SubmitLogChunk(buffer->tail);
+            buffer->tail = nullptr;
+
+            fwrite(text, sizeof(char), length, __LOG_STREAM__);
+            return (ssize_t) length;
+        }
+
+        if (tail_len > 0)
+            memcpy(GetChunkText(chunk), GetChunkText(buffer->tail), tail_len);
+
+        memcpy(GetChunkText(chunk) + tail_len, text, lines_len);
+        chunk->length = tail_len + lines_len;
+
+        free(buffer->tail);
+        buffer->tail = nullptr;
+
+        SubmitLogChunk(chunk);
+    }
+
+    AppendToLogTail(buffer, text + lines_len, length - lines_len);
+
+    return (ssize_t) length;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static void AppendToLogTail(LogThreadBuffer* buffer, const char* text, const size_t length)
+{
+    assert(buffer);
+    assert(text);
+
+    if (length == 0)
+        return;
+
+    size_t    tail_len = (buffer->tail != nullptr) ? buffer->tail->length : 0;
+    LogChunk* tail     = (LogChunk*) realloc(buffer->tail, sizeof(LogChunk) + tail_len + length);
+
+    if (tail == nullptr)
+    {
+        fwrite(text, sizeof(char), length, __LOG_STREAM__);
+        return;
+    }
+
+    memcpy(GetChunkText(tail) + tail_len, text, length);
+
+    tail->next     = nullptr;
+    tail->length   = tail_len + length;
+    tail->capacity = tail_len + length;
+
+    buffer->tail   = tail;
+}
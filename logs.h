@@ -9,7 +9,9 @@
 * \brief Contains log functions
 */
 
-static const size_t MAX_FILE_NAME_LEN = 100;
+static const size_t MAX_FILE_NAME_LEN   = 100;
+static const size_t LOG_CHUNK_SIZE      = 1 << 16;   ///< log text of thread is written by pieces of this size
+static const size_t LOG_FLUSH_PERIOD_MS = 100;       ///< complete lines are taken from partial buffers with this period
 
 /************************************************************//**
  * @brief Opens log file, also close it when program shuts down
@@ -19,10 +21,17 @@ static const size_t MAX_FILE_NAME_LEN = 100;
 void OpenLogFile(const char* FILE_NAME);
 
 /************************************************************//**
- * @brief Closes log file
+ * @brief Closes log file, buffered records of all threads are written before it
  ************************************************************/
 void CloseLogFile();
 
+/************************************************************//**
+ * @brief Gives buffered lines of all threads to background flusher
+ * and waits until they are written in log file, unfinished line
+ * is cut only in current thread
+ ************************************************************/
+void FlushLog();
+
 /************************************************************//**
  * @brief Dumping information in logs
  *
@@ -36,7 +45,8 @@ void CloseLogFile();
 int LogDump(dump_f dump_func, const void* obj, const char* func, const char* file, const int line);
 
 /************************************************************//**
- * @brief Prints text in log (printf analogue)
+ * @brief Prints text in log (printf analogue), text is buffered
+ * by thread and written in file by background flusher
  *
  * @param[in] format text format (like in printf)
  * @param[in] ... extra arguments
@@ -1,12 +1,17 @@
 #include "ptr_list.h"
 #include "graphs.h"
 
-static const char* DOT_FILE = "tmp.dot";
-static const int   POISON   = -2147483647;
+static const int    POISON               = -2147483647;
+static const size_t FIRST_BLOCK_CAPACITY = 64;
+static const size_t MAX_BLOCK_CAPACITY   = 65536;
 
-static PtrListElem* InitListElement(const int data, PtrListElem* prev,
-                                                    PtrListElem* next, ErrorInfo* error);
-static inline void DestructListElement(PtrListElem* elem);
+static PtrListElem* InitListElement(ptrlist_t* list, const int data, PtrListElem* prev,
+                                    PtrListElem* next, ErrorInfo* error);
+static inline void DestructListElement(ptrlist_t* list, PtrListElem* elem);
+
+static PtrListElem*  TakeElementFromPool(ptrlist_t* list);
+static PtrListBlock* AddPoolBlock(ptrlist_t* list);
+static inline PtrListElem* GetBlockElements(PtrListBlock* block);
 
 static void CheckRemovingElement(const ptrlist_t* list, PtrListElem* pos, ErrorInfo* error);
 static void CheckGettingElement(const ptrlist_t* list, PtrListElem* pos, ErrorInfo* error);
@@ -35,18 +40,31 @@ static inline void DrawPtrListArrows(FILE* dotf, const ptrlist_t* list);
 #ifdef CHECK_PTRLIST
 #undef CHECK_PTRLIST
 #endif
+#ifdef _DEBUG
 #define CHECK_PTRLIST(list) do                                                              \
                             {                                                               \
                                 PtrListErrors list_err_ = PtrListVerify(list);              \
                                 if (list_err_ != PtrListErrors::NONE)                       \
                                     return list_err_;                                       \
                             } while(0)
+#else
+// full verification walks through the whole list, so release build checks only fictive element
+#define CHECK_PTRLIST(list) do                                                              \
+                            {                                                               \
+                                if ((list)->fictive->data != POISON)                        \
+                                    return PtrListErrors::DAMAGED_FICTIVE;                  \
+                            } while(0)
+#endif
 
 PtrListErrors PtrListCtor(ptrlist_t* list, ErrorInfo* error)
 {
     assert(list);
 
-    PtrListElem* fictive_elem = InitListElement(POISON, nullptr, nullptr, error);
+    list->blocks     = nullptr;
+    list->block_used = 0;
+    list->free_elems = nullptr;
+
+    PtrListElem* fictive_elem = InitListElement(list, POISON, nullptr, nullptr, error);
     RETURN_IF_PTRLISTERROR((PtrListErrors) error->code);
 
     fictive_elem->next = fictive_elem;
@@ -75,12 +93,13 @@ PtrListElem* GetPtrListTail(const ptrlist_t* list)
 
 //-----------------------------------------------------------------------------------------------------
 
-static PtrListElem* InitListElement(const int data, PtrListElem* prev,
+static PtrListElem* InitListElement(ptrlist_t* list, const int data, PtrListElem* prev,
                                     PtrListElem* next, ErrorInfo* error)
 {
+    assert(list);
     assert(error);
 
-    PtrListElem* elem = (PtrListElem*) calloc(1, sizeof(PtrListElem));
+    PtrListElem* elem = TakeElementFromPool(list);
     if (elem == nullptr)
     {
         error->code = (int) PtrListErrors::ALLOCATE_MEMORY;
@@ -101,27 +120,96 @@ void PtrListDtor(ptrlist_t* list)
 {
     assert(list);
 
-    PtrListElem* elem     = list->fictive;
-    size_t       elem_amt = list->size + 1;
-    //     fictive --------------------^
+    // elements are not freed one by one, they all live in pool blocks
+    PtrListBlock* block = list->blocks;
 
-    for (int i = 0; i < elem_amt; i++)
+    while (block != nullptr)
     {
-        DestructListElement(elem);
+        PtrListBlock* next_block = block->next;
+        free(block);
 
-        elem = elem->next;
+        block = next_block;
     }
 
-    list->fictive = nullptr;
-    list->size    = 0;
+    list->blocks     = nullptr;
+    list->block_used = 0;
+    list->free_elems = nullptr;
+
+    list->fictive    = nullptr;
+    list->size       = 0;
 }
 
 //-----------------------------------------------------------------------------------------------------
 
-static inline void DestructListElement(PtrListElem* elem)
+static inline void DestructListElement(ptrlist_t* list, PtrListElem* elem)
 {
+    assert(list);
     assert(elem);
-    free(elem);
+
+    //      v------ marks element as removed, it is not in list anymore
+    elem->prev = nullptr;
+    elem->next = list->free_elems;
+
+    list->free_elems = elem;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static PtrListElem* TakeElementFromPool(ptrlist_t* list)
+{
+    assert(list);
+
+    if (list->free_elems != nullptr)
+    {
+        PtrListElem* elem = list->free_elems;
+        list->free_elems  = elem->next;
+
+        return elem;
+    }
+
+    if (list->blocks == nullptr || list->block_used == list->blocks->capacity)
+    {
+        if (AddPoolBlock(list) == nullptr)
+            return nullptr;
+    }
+
+    return &GetBlockElements(list->blocks)[list->block_used++];
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static PtrListBlock* AddPoolBlock(ptrlist_t* list)
+{
+    assert(list);
+
+    size_t capacity = FIRST_BLOCK_CAPACITY;
+
+    //                         v------ every next block is twice bigger
+    if (list->blocks != nullptr && list->blocks->capacity < MAX_BLOCK_CAPACITY)
+        capacity = list->blocks->capacity * 2;
+    else if (list->blocks != nullptr)
+        capacity = MAX_BLOCK_CAPACITY;
+
+    PtrListBlock* block = (PtrListBlock*) malloc(sizeof(PtrListBlock) + capacity * sizeof(PtrListElem));
+    if (block == nullptr)
+        return nullptr;
+
+    block->next     = list->blocks;
+    block->capacity = capacity;
+
+    list->blocks     = block;
+    list->block_used = 0;
+
+    return block;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+static inline PtrListElem* GetBlockElements(PtrListBlock* block)
+{
+    assert(block);
+
+    return (PtrListElem*) (block + 1);
 }
 
 //-----------------------------------------------------------------------------------------------------
@@ -133,7 +221,7 @@ PtrListErrors PtrListInsertAfterElem(ptrlist_t* list, PtrListElem* pos, const in
 
     CHECK_PTRLIST(list);
 
-    PtrListElem* inserted_elem = InitListElement(value, pos, pos->next, error);
+    PtrListElem* inserted_elem = InitListElement(list, value, pos, pos->next, error);
     *inserted_pos              = inserted_elem;
     RETURN_IF_PTRLISTERROR((PtrListErrors) error->code);
 
@@ -157,7 +245,7 @@ PtrListErrors PtrListInsertBeforeElem(ptrlist_t* list, PtrListElem* pos, const i
 
     CHECK_PTRLIST(list);
 
-    PtrListElem* inserted_elem = InitListElement(value, pos->prev, pos, error);
+    PtrListElem* inserted_elem = InitListElement(list, value, pos->prev, pos, error);
     *inserted_pos              = inserted_elem;
     RETURN_IF_PTRLISTERROR((PtrListErrors) error->code);
 
@@ -191,7 +279,7 @@ PtrListErrors PtrListRemoveElem(ptrlist_t* list, PtrListElem* pos, ErrorInfo* er
     prev_elem->next = next_elem;
     next_elem->prev = prev_elem;
 
-    DestructListElement(pos);
+    DestructListElement(list, pos);
     list->size--;
 
     return PtrListErrors::NONE;
@@ -218,7 +306,7 @@ static void CheckRemovingElement(const ptrlist_t* list, PtrListElem* pos, ErrorI
         return;
     }
 
-    if (((pos->prev)->next) != pos || ((pos->next)->prev) != pos)
+    if (pos->prev == nullptr || ((pos->prev)->next) != pos || ((pos->next)->prev) != pos)
     {
         error->code = (int) PtrListErrors::UNKNOWN_ELEMENT;
         error->data = pos;
@@ -241,7 +329,7 @@ static void CheckGettingElement(const ptrlist_t* list, PtrListElem* pos, ErrorIn
         return;
     }
 
-    if (((pos->prev)->next) != pos || ((pos->next)->prev) != pos)
+    if (pos->prev == nullptr || ((pos->prev)->next) != pos || ((pos->next)->prev) != pos)
     {
         error->code = (int) PtrListErrors::UNKNOWN_ELEMENT;
         error->data = pos;
@@ -439,20 +527,18 @@ static void DrawPtrListGraph(const ptrlist_t* list)
 {
     assert(list);
 
-    FILE* dotf = fopen(DOT_FILE, "w");
-
-    StartGraph(dotf);
-
-    DrawPtrListInfo(dotf, list);
-    DrawPtrListElements(dotf, list);
-    CenterPtrListElements(dotf, list);
-    DrawPtrListArrows(dotf, list);
+    GraphDump dump = {};
+    StartGraphDump(&dump);
 
-    EndGraph(dotf);
-
-    fclose(dotf);
+    if (dump.dotf != nullptr)
+    {
+        DrawPtrListInfo(dump.dotf, list);
+        DrawPtrListElements(dump.dotf, list);
+        CenterPtrListElements(dump.dotf, list);
+        DrawPtrListArrows(dump.dotf, list);
+    }
 
-    MakeImgFromDot(DOT_FILE);
+    EndGraphDump(&dump);
 }
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::;::::::::::::::::::::::::::
@@ -10,11 +10,23 @@ struct PtrListElem
     PtrListElem* prev;
 };
 
+/// header of memory block, its elements go right after it
+struct PtrListBlock
+{
+    PtrListBlock* next;
+
+    size_t capacity;
+};
+
 struct PtrList
 {
     PtrListElem* fictive;
 
     size_t size;
+
+    PtrListBlock* blocks;       ///< newest block first
+    size_t        block_used;   ///< elements taken from newest block
+    PtrListElem*  free_elems;   ///< removed elements, linked through next
 };
 
 enum class PtrListErrors
@@ -0,0 +1,58 @@
+#ifndef __SHARDED_LIST_H_
+#define __SHARDED_LIST_H_
+
+/*! \file
+* \brief Contains list, which is split into shards, one shard per writing thread
+*/
+
+#include "fast_list.h"
+
+static const size_t LIST_SHARD_ALIGNMENT = 64;
+
+/// list of one thread, shards do not share cache lines, so their appends do not touch each other
+template <class ListT>
+struct alignas(LIST_SHARD_ALIGNMENT) ListShard
+{
+    ListT list;
+};
+
+/// one logical list: elements of shard 0 in their order, then elements of shard 1 and so on
+template <class ListT = list_t>
+struct ShardedList
+{
+    typedef ListT shard_t;
+
+    ListShard<ListT>* shards;
+    size_t            shards_amt;
+};
+
+template <class ListT>
+ListErrors ShardedListCtor(ShardedList<ListT>* sharded, const size_t shards_amt, ErrorInfo* error,
+                           const size_t shard_capacity = DEFAULT_LIST_CAPACITY);
+template <class ListT>
+void       ShardedListDtor(ShardedList<ListT>* sharded);
+
+/// shard is owned by one thread, other shards can be changed by other threads at the same time
+template <class ListT>
+inline ListT* GetListShard(ShardedList<ListT>* sharded, const size_t shard)
+{
+    assert(sharded);
+    assert(shard < sharded->shards_amt);
+
+    return &sharded->shards[shard].list;
+}
+
+template <class ListT>
+ListErrors ShardedListAppend(ShardedList<ListT>* sharded, const size_t shard, typename ListT::data_t value,
+                             size_t* inserted_pos, ErrorInfo* error);
+template <class ListT>
+size_t     GetShardedListSize(const ShardedList<ListT>* sharded);
+
+/// copies all shards into new linearized list, shards are not changed,
+/// nobody can change shards until merge ends
+template <class ListT>
+ListErrors ShardedListMerge(const ShardedList<ListT>* sharded, ListT* merged, ErrorInfo* error);
+
+#include "sharded_list_impl.h"
+
+#endif
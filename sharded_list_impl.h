@@ -0,0 +1,194 @@
+/*! \file
+* \brief Contains sharded list template functions, included only by sharded_list.h
+*/
+
+#ifndef __SHARDED_LIST_IMPL_H_
+#define __SHARDED_LIST_IMPL_H_
+
+#include <assert.h>
+#include <new>
+#include <thread>
+#include <system_error>
+
+static const size_t MIN_PARALLEL_MERGE_ELEMS = 1 << 16;
+
+template <class ListT>
+static void CopyShardInMergedList(const ListT* shard, ListT* merged, const size_t first_pos);
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors ShardedListCtor(ShardedList<ListT>* sharded, const size_t shards_amt, ErrorInfo* error,
+                           const size_t shard_capacity)
+{
+    assert(sharded);
+    assert(error);
+    assert(shards_amt > 0);
+
+    //                                                                  v------ size is multiple of alignment
+    sharded->shards     = (ListShard<ListT>*) aligned_alloc(LIST_SHARD_ALIGNMENT, shards_amt * sizeof(ListShard<ListT>));
+    sharded->shards_amt = 0;
+
+    if (sharded->shards == nullptr)
+    {
+        error->code = (int) ListErrors::ALLOCATE_MEMORY;
+        error->data = "SHARDS ARRAY";
+        return ListErrors::ALLOCATE_MEMORY;
+    }
+
+    for (size_t shard = 0; shard < shards_amt; shard++)
+    {
+        new (&sharded->shards[shard]) ListShard<ListT>();
+
+        if (ListCtor(&sharded->shards[shard].list, error, shard_capacity) != ListErrors::NONE)
+        {
+            ShardedListDtor(sharded);
+            return (ListErrors) error->code;
+        }
+
+        sharded->shards_amt++;
+    }
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+void ShardedListDtor(ShardedList<ListT>* sharded)
+{
+    assert(sharded);
+
+    for (size_t shard = 0; shard < sharded->shards_amt; shard++)
+        ListDtor(&sharded->shards[shard].list);
+
+    free(sharded->shards);
+
+    sharded->shards     = nullptr;
+    sharded->shards_amt = 0;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors ShardedListAppend(ShardedList<ListT>* sharded, const size_t shard, typename ListT::data_t value,
+                             size_t* inserted_pos, ErrorInfo* error)
+{
+    assert(sharded);
+    assert(inserted_pos);
+    assert(error);
+
+    return ListInsertBeforeElem(GetListShard(sharded, shard), FICTIVE_ELEM_POS, std::move(value),
+                                inserted_pos, error);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+size_t GetShardedListSize(const ShardedList<ListT>* sharded)
+{
+    assert(sharded);
+
+    size_t size = 0;
+
+    for (size_t shard = 0; shard < sharded->shards_amt; shard++)
+        size += sharded->shards[shard].list.size;
+
+    return size;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors ShardedListMerge(const ShardedList<ListT>* sharded, ListT* merged, ErrorInfo* error)
+{
+    assert(sharded);
+    assert(merged);
+    assert(error);
+
+    size_t size = GetShardedListSize(sharded);
+
+    ListCtor(merged, error, size + 1);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    // every shard gets its own range of slots, so shards are copied without any synchronization
+    std::thread* threads = nullptr;
+
+    if (size >= MIN_PARALLEL_MERGE_ELEMS && sharded->shards_amt > 1)
+        threads = new (std::nothrow) std::thread[sharded->shards_amt - 1];
+
+    size_t first_pos = 1 + sharded->shards[0].list.size;
+
+    for (size_t shard = 1; shard < sharded->shards_amt; shard++)
+    {
+        const ListT* shard_list = &sharded->shards[shard].list;
+
+        // shard of thread, which can not be started, is copied by caller
+        try
+        {
+            if (threads)
+                threads[shard - 1] = std::thread(CopyShardInMergedList<ListT>, shard_list, merged, first_pos);
+            else
+                CopyShardInMergedList(shard_list, merged, first_pos);
+        }
+        catch (const std::system_error&)
+        {
+            CopyShardInMergedList(shard_list, merged, first_pos);
+        }
+
+        first_pos += shard_list->size;
+    }
+
+    //                                                      v------ first shard is copied by caller
+    CopyShardInMergedList(&sharded->shards[0].list, merged, 1);
+
+    if (threads)
+    {
+        for (size_t shard = 1; shard < sharded->shards_amt; shard++)
+            if (threads[shard - 1].joinable())
+                threads[shard - 1].join();
+
+        delete [] threads;
+    }
+
+    typedef typename ListT::index_t index_t;
+
+    // copied links already go over boundaries of shards, only ends of the list are left
+    if (size > 0)
+        ListNext(merged, size) = (index_t) FICTIVE_ELEM_POS;
+
+    ListNext(merged, FICTIVE_ELEM_POS) = (size > 0) ? (index_t) 1 : (index_t) FICTIVE_ELEM_POS;
+    ListPrev(merged, FICTIVE_ELEM_POS) = (index_t) size;
+
+    merged->size       = size;
+    merged->used       = size + 1;
+    merged->free       = GetFirstUnusedFreeElem(merged);
+    merged->linearized = true;
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void CopyShardInMergedList(const ListT* shard, ListT* merged, const size_t first_pos)
+{
+    assert(shard);
+    assert(merged);
+
+    typedef typename ListT::data_t  T;
+    typedef typename ListT::index_t index_t;
+
+    size_t pos = first_pos;
+
+    for (size_t elem = (size_t) GetListHead(shard); elem != FICTIVE_ELEM_POS; elem = (size_t) ListNext(shard, elem))
+    {
+        new (&ListData(merged, pos)) T(ListData(shard, elem));
+        ListPrev(merged, pos) = (index_t) (pos - 1);
+        ListNext(merged, pos) = (index_t) (pos + 1);
+
+        pos++;
+    }
+}
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef __UNROLLED_LIST_H_
+#define __UNROLLED_LIST_H_
+
+/*! \file
+* \brief Contains unrolled list: fast list of blocks, every block keeps several values
+*/
+
+#include <type_traits>
+
+#include "fast_list.h"
+
+static const size_t UNROLLED_NODE_SIZE = 64;    ///< default block with its links fills one cache line
+
+/// values of one node, they are kept in their logical order at the start of block
+template <typename T, size_t N>
+struct UnrolledBlock
+{
+    T   values[N];
+    int amount;
+};
+
+/// position of value: node of block list and offset in its block
+struct UnrolledPos
+{
+    size_t node;
+    size_t offset;
+};
+
+/// amount of values in block, which fits in one cache line with amount and links
+template <typename T>
+constexpr size_t GetUnrolledBlockValues()
+{
+    //                              v------ amount, next and prev
+    size_t values = (UNROLLED_NODE_SIZE - 3 * sizeof(int)) / sizeof(T);
+
+    return (values < 2) ? 2 : values;
+}
+
+/// values are moved by copying of bytes, so only trivially copyable types are allowed
+template <typename T, size_t N = GetUnrolledBlockValues<T>(), ListChecks checks = DEFAULT_LIST_CHECKS>
+struct UnrolledList
+{
+    static_assert(std::is_trivially_copyable<T>::value, "unrolled list copies values as bytes");
+    static_assert(N >= 2, "block has to keep at least two values to be split");
+
+    typedef T                                                     data_t;
+    typedef UnrolledBlock<T, N>                                   block_t;
+    typedef FastList<block_t, ListLayout::AOS, checks>            blocks_t;
+
+    static const size_t BLOCK_VALUES = N;
+
+    blocks_t blocks;
+    size_t   size;      ///< amount of values in all blocks
+};
+
+typedef UnrolledList<int> unrolled_list_t;
+
+template <class ListT>
+ListErrors  UnrolledListCtor(ListT* list, ErrorInfo* error, const size_t capacity = DEFAULT_LIST_CAPACITY);
+template <class ListT>
+void        UnrolledListDtor(ListT* list);
+
+/// value by position, which has to be valid
+template <class ListT>
+inline typename ListT::data_t& UnrolledListData(ListT* list, const UnrolledPos pos)
+{
+    assert(list);
+
+    return ListData(&list->blocks, pos.node).values[pos.offset];
+}
+
+template <class ListT>
+inline const typename ListT::data_t& UnrolledListData(const ListT* list, const UnrolledPos pos)
+{
+    assert(list);
+
+    return ListData(&list->blocks, pos.node).values[pos.offset];
+}
+
+// positions are (node, offset) pairs, node 0 is fictive position before the first and after the last value;
+// insert or remove changes offsets of values after it in its block and can move them to neighbour block
+
+template <class ListT>
+UnrolledPos GetUnrolledListHead(const ListT* list);
+template <class ListT>
+UnrolledPos GetUnrolledListTail(const ListT* list);
+template <class ListT>
+UnrolledPos GetUnrolledListNext(const ListT* list, const UnrolledPos pos);
+template <class ListT>
+UnrolledPos GetUnrolledListPosByIndex(const ListT* list, const size_t index);
+template <class ListT>
+ListErrors  GetUnrolledListElement(const ListT* list, const UnrolledPos pos, typename ListT::data_t* destination,
+                                   ErrorInfo* error);
+
+template <class ListT>
+ListErrors  UnrolledListInsertAfter(ListT* list, const UnrolledPos pos, const typename ListT::data_t value,
+                                    UnrolledPos* inserted_pos, ErrorInfo* error);
+template <class ListT>
+ListErrors  UnrolledListInsertBefore(ListT* list, const UnrolledPos pos, const typename ListT::data_t value,
+                                     UnrolledPos* inserted_pos, ErrorInfo* error);
+template <class ListT>
+ListErrors  UnrolledListRemove(ListT* list, const UnrolledPos pos, ErrorInfo* error);
+
+#include "unrolled_list_impl.h"
+
+#endif
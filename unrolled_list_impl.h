@@ -0,0 +1,325 @@
+/*! \file
+* \brief Contains unrolled list template functions, included only by unrolled_list.h
+*/
+
+#ifndef __UNROLLED_LIST_IMPL_H_
+#define __UNROLLED_LIST_IMPL_H_
+
+#include <assert.h>
+#include <string.h>
+
+template <class ListT>
+static ListErrors InsertInUnrolledBlock(ListT* list, size_t node, size_t offset, const typename ListT::data_t value,
+                                        UnrolledPos* inserted_pos, ErrorInfo* error);
+template <class ListT>
+static ListErrors AddUnrolledBlock(ListT* list, const size_t prev_node, size_t* node, ErrorInfo* error);
+template <class ListT>
+static void       CheckUnrolledPos(const ListT* list, const UnrolledPos pos, ErrorInfo* error);
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors UnrolledListCtor(ListT* list, ErrorInfo* error, const size_t capacity)
+{
+    assert(list);
+    assert(error);
+
+    list->size = 0;
+
+    return ListCtor(&list->blocks, error, capacity / ListT::BLOCK_VALUES + 1);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+void UnrolledListDtor(ListT* list)
+{
+    assert(list);
+
+    ListDtor(&list->blocks);
+
+    list->size = 0;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+UnrolledPos GetUnrolledListHead(const ListT* list)
+{
+    assert(list);
+
+    return {(size_t) GetListHead(&list->blocks), 0};
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+UnrolledPos GetUnrolledListTail(const ListT* list)
+{
+    assert(list);
+
+    size_t node = (size_t) GetListTail(&list->blocks);
+
+    if (node == FICTIVE_ELEM_POS)
+        return {FICTIVE_ELEM_POS, 0};
+
+    return {node, (size_t) ListData(&list->blocks, node).amount - 1};
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+UnrolledPos GetUnrolledListNext(const ListT* list, const UnrolledPos pos)
+{
+    assert(list);
+
+    if (pos.node == FICTIVE_ELEM_POS)
+        return GetUnrolledListHead(list);
+
+    if (pos.offset + 1 < (size_t) ListData(&list->blocks, pos.node).amount)
+        return {pos.node, pos.offset + 1};
+
+    return {(size_t) ListNext(&list->blocks, pos.node), 0};
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+UnrolledPos GetUnrolledListPosByIndex(const ListT* list, const size_t index)
+{
+    assert(list);
+
+    if (index >= list->size)
+        return {FICTIVE_ELEM_POS, 0};
+
+    size_t node   = (size_t) GetListHead(&list->blocks);
+    size_t offset = index;
+
+    // whole blocks are skipped, so walk is shorter in block factor times
+    while (offset >= (size_t) ListData(&list->blocks, node).amount)
+    {
+        offset -= (size_t) ListData(&list->blocks, node).amount;
+        node    = (size_t) ListNext(&list->blocks, node);
+    }
+
+    return {node, offset};
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors GetUnrolledListElement(const ListT* list, const UnrolledPos pos, typename ListT::data_t* destination,
+                                  ErrorInfo* error)
+{
+    assert(list);
+    assert(destination);
+    assert(error);
+
+    CheckUnrolledPos(list, pos, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    *destination = UnrolledListData(list, pos);
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors UnrolledListInsertAfter(ListT* list, const UnrolledPos pos, const typename ListT::data_t value,
+                                   UnrolledPos* inserted_pos, ErrorInfo* error)
+{
+    assert(list);
+    assert(inserted_pos);
+    assert(error);
+
+    if (pos.node != FICTIVE_ELEM_POS)
+    {
+        CheckUnrolledPos(list, pos, error);
+        RETURN_IF_LISTERROR((ListErrors) error->code);
+
+        return InsertInUnrolledBlock(list, pos.node, pos.offset + 1, value, inserted_pos, error);
+    }
+
+    // value after fictive position becomes the first one
+    size_t head = (size_t) GetListHead(&list->blocks);
+
+    if (head == FICTIVE_ELEM_POS)
+    {
+        AddUnrolledBlock(list, FICTIVE_ELEM_POS, &head, error);
+        RETURN_IF_LISTERROR((ListErrors) error->code);
+    }
+
+    return InsertInUnrolledBlock(list, head, 0, value, inserted_pos, error);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors UnrolledListInsertBefore(ListT* list, const UnrolledPos pos, const typename ListT::data_t value,
+                                    UnrolledPos* inserted_pos, ErrorInfo* error)
+{
+    assert(list);
+    assert(inserted_pos);
+    assert(error);
+
+    if (pos.node != FICTIVE_ELEM_POS)
+    {
+        CheckUnrolledPos(list, pos, error);
+        RETURN_IF_LISTERROR((ListErrors) error->code);
+
+        return InsertInUnrolledBlock(list, pos.node, pos.offset, value, inserted_pos, error);
+    }
+
+    // value before fictive position becomes the last one
+    size_t tail = (size_t) GetListTail(&list->blocks);
+
+    if (tail == FICTIVE_ELEM_POS)
+    {
+        AddUnrolledBlock(list, FICTIVE_ELEM_POS, &tail, error);
+        RETURN_IF_LISTERROR((ListErrors) error->code);
+    }
+
+    return InsertInUnrolledBlock(list, tail, (size_t) ListData(&list->blocks, tail).amount, value,
+                                 inserted_pos, error);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static ListErrors InsertInUnrolledBlock(ListT* list, size_t node, size_t offset, const typename ListT::data_t value,
+                                        UnrolledPos* inserted_pos, ErrorInfo* error)
+{
+    assert(list);
+    assert(inserted_pos);
+    assert(error);
+
+    typedef typename ListT::data_t  T;
+    typedef typename ListT::block_t block_t;
+
+    const size_t N = ListT::BLOCK_VALUES;
+
+    if ((size_t) ListData(&list->blocks, node).amount == N)
+    {
+        size_t new_node = FICTIVE_ELEM_POS;
+
+        AddUnrolledBlock(list, node, &new_node, error);
+        RETURN_IF_LISTERROR((ListErrors) error->code);
+
+        block_t* block     = &ListData(&list->blocks, node);
+        block_t* new_block = &ListData(&list->blocks, new_node);
+
+        // value after the last one starts new block, so appends fill blocks completely,
+        // otherwise upper half of full block is moved
+        size_t moved = (offset == N) ? 0 : N / 2;
+
+        memcpy(new_block->values, block->values + N - moved, moved * sizeof(T));
+
+        new_block->amount = (int) moved;
+        block->amount     = (int) (N - moved);
+
+        if (offset >= N - moved)
+        {
+            offset -= N - moved;
+            node    = new_node;
+        }
+    }
+
+    block_t* block  = &ListData(&list->blocks, node);
+    size_t   amount = (size_t) block->amount;
+
+    memmove(block->values + offset + 1, block->values + offset, (amount - offset) * sizeof(T));
+
+    block->values[offset] = value;
+    block->amount++;
+
+    list->size++;
+
+    *inserted_pos = {node, offset};
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static ListErrors AddUnrolledBlock(ListT* list, const size_t prev_node, size_t* node, ErrorInfo* error)
+{
+    assert(list);
+    assert(node);
+    assert(error);
+
+    return ListInsertAfterElem(&list->blocks, prev_node, typename ListT::block_t{}, node, error);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors UnrolledListRemove(ListT* list, const UnrolledPos pos, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    typedef typename ListT::data_t  T;
+    typedef typename ListT::block_t block_t;
+
+    const size_t N = ListT::BLOCK_VALUES;
+
+    CheckUnrolledPos(list, pos, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    block_t* block  = &ListData(&list->blocks, pos.node);
+    size_t   amount = (size_t) block->amount;
+
+    memmove(block->values + pos.offset, block->values + pos.offset + 1, (amount - pos.offset - 1) * sizeof(T));
+
+    block->amount--;
+    list->size--;
+
+    if (block->amount == 0)
+        return ListRemoveElem(&list->blocks, pos.node, error);
+
+    // sparse block takes values of the next one, if they fit, so blocks do not stay almost empty
+    size_t next = (size_t) ListNext(&list->blocks, pos.node);
+
+    if (next == FICTIVE_ELEM_POS || (size_t) block->amount >= N / 2)
+        return ListErrors::NONE;
+
+    block_t* next_block = &ListData(&list->blocks, next);
+
+    if ((size_t) (block->amount + next_block->amount) > N)
+        return ListErrors::NONE;
+
+    memcpy(block->values + block->amount, next_block->values, (size_t) next_block->amount * sizeof(T));
+    block->amount += next_block->amount;
+
+    return ListRemoveElem(&list->blocks, next, error);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void CheckUnrolledPos(const ListT* list, const UnrolledPos pos, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    if constexpr (!IsListChecked<const typename ListT::blocks_t*>())
+        return;
+
+    if (IsEmptyListElem(&list->blocks, pos.node))
+    {
+        error->code = (int) ListErrors::EMPTY_ELEMENT;
+        error->data = &list->blocks;
+        return;
+    }
+
+    if (pos.offset >= (size_t) ListData(&list->blocks, pos.node).amount)
+    {
+        error->code = (int) ListErrors::INVALID_INDEX;
+        error->data = &list->blocks;
+        return;
+    }
+}
+
+#endif
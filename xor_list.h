@@ -0,0 +1,121 @@
+#ifndef __XOR_LIST_H_
+#define __XOR_LIST_H_
+
+/*! \file
+* \brief Contains xor list: compact list, every element keeps one link - xor of its previous and next slots
+*/
+
+#include <type_traits>
+
+#include "fast_list.h"
+
+/// busy element keeps prev ^ next, free element keeps negated next free slot minus one, so it is always negative
+template <typename T, typename IndexT = int>
+struct XorListElem
+{
+    T      data;
+    IndexT link;
+};
+
+/// element is reached only together with its previous element, slot 0 is fictive element
+struct XorListCursor
+{
+    size_t prev;
+    size_t cur;
+};
+
+/// elements are moved by realloc, so only trivially copyable types are allowed
+template <typename T, ListChecks checks = DEFAULT_LIST_CHECKS, typename IndexT = int>
+struct XorList
+{
+    static_assert(std::is_trivially_copyable<T>::value, "xor list grows by realloc of elements");
+    static_assert(std::is_integral<IndexT>::value && std::is_signed<IndexT>::value,
+                  "free slots are marked by negative links");
+
+    typedef T                       data_t;
+    typedef IndexT                  index_t;
+    typedef XorListElem<T, IndexT>  slot_t;
+
+#ifdef _DEBUG
+    /// debug build always verifies everything
+    static const ListChecks CHECKS = ListChecks::PARANOID;
+#else
+    static const ListChecks CHECKS = checks;
+#endif
+
+    /// fictive element keeps head ^ tail, so list is a ring and ends are changed as other elements
+    slot_t* elems;
+
+    IndexT head;
+    IndexT tail;
+    IndexT free;        ///< the last removed slot, 0 if there are no removed slots
+
+    size_t capacity;
+    size_t size;
+    size_t used;        ///< slots from used to capacity were never taken
+};
+
+typedef XorList<int> xor_list_t;
+
+/// largest capacity, which slots can be addressed by links of the list
+template <class ListT>
+constexpr size_t GetMaxXorListCapacity()
+{
+    return (size_t) std::numeric_limits<typename ListT::index_t>::max() + 1;
+}
+
+template <class ListT>
+ListErrors  XorListCtor(ListT* list, ErrorInfo* error, size_t capacity = DEFAULT_LIST_CAPACITY);
+template <class ListT>
+void        XorListDtor(ListT* list);
+template <class ListT>
+ListErrors  XorListVerify(const ListT* list);
+
+/// value by cursor, which has to point to element
+template <class ListT>
+inline typename ListT::data_t& XorListData(ListT* list, const XorListCursor cursor)
+{
+    assert(list);
+
+    return list->elems[cursor.cur].data;
+}
+
+template <class ListT>
+inline const typename ListT::data_t& XorListData(const ListT* list, const XorListCursor cursor)
+{
+    assert(list);
+
+    return list->elems[cursor.cur].data;
+}
+
+// cursor {prev, cur} points to element cur, links are walked in both directions from it;
+// cursor of the first element is {0, head}, cursor {tail, 0} is after the last one, both are {0, 0} in empty list.
+// insert or remove changes previous element of its neighbour, so only cursors returned by them stay valid
+
+template <class ListT>
+XorListCursor GetXorListBegin(const ListT* list);
+template <class ListT>
+XorListCursor GetXorListEnd(const ListT* list);
+template <class ListT>
+XorListCursor GetXorListNext(const ListT* list, const XorListCursor cursor);
+template <class ListT>
+XorListCursor GetXorListPrev(const ListT* list, const XorListCursor cursor);
+template <class ListT>
+ListErrors    GetXorListElement(const ListT* list, const XorListCursor cursor, typename ListT::data_t* destination,
+                                ErrorInfo* error);
+
+/// cursor stays valid, inserted element is after cur
+template <class ListT>
+ListErrors    XorListInsertAfter(ListT* list, const XorListCursor cursor, const typename ListT::data_t value,
+                                 XorListCursor* inserted, ErrorInfo* error);
+/// inserted element is before cur, cursor of cur becomes {inserted->cur, cursor.cur}
+template <class ListT>
+ListErrors    XorListInsertBefore(ListT* list, const XorListCursor cursor, const typename ListT::data_t value,
+                                  XorListCursor* inserted, ErrorInfo* error);
+/// next gets cursor of element after removed one
+template <class ListT>
+ListErrors    XorListRemove(ListT* list, const XorListCursor cursor, XorListCursor* next, ErrorInfo* error);
+
+#include "xor_list_impl.h"
+
+#endif
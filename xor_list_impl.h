@@ -0,0 +1,475 @@
+/*! \file
+* \brief Contains xor list template functions, included only by xor_list.h
+*/
+
+#ifndef __XOR_LIST_IMPL_H_
+#define __XOR_LIST_IMPL_H_
+
+#include <assert.h>
+#include <stdlib.h>
+
+template <class ListT>
+static ListErrors  TakeXorListSlot(ListT* list, size_t* pos, ErrorInfo* error);
+template <class ListT>
+static ListErrors  MakeXorListLonger(ListT* list, ErrorInfo* error);
+template <class ListT>
+static inline void LinkXorListElem(ListT* list, const size_t pos, const size_t prev_pos, const size_t next_pos);
+template <class ListT>
+static inline void UnlinkXorListElem(ListT* list, const size_t pos, const size_t prev_pos, const size_t next_pos);
+template <class ListT>
+static inline void XorListLink(ListT* list, const size_t pos, const size_t removed_pos, const size_t added_pos);
+template <class ListT>
+static inline bool IsEmptyXorListElem(const ListT* list, const size_t pos);
+template <class ListT>
+static void        CheckXorListCursor(const ListT* list, const XorListCursor cursor, ErrorInfo* error);
+
+#ifdef CHECK_XOR_LIST
+#undef CHECK_XOR_LIST
+#endif
+#define CHECK_XOR_LIST(list)    do                                                          \
+                                {                                                           \
+                                    if constexpr (IsListChecked<decltype(list)>())          \
+                                    {                                                       \
+                                        ListErrors list_err_ = XorListVerify(list);         \
+                                        if (list_err_ != ListErrors::NONE)                  \
+                                            return list_err_;                               \
+                                    }                                                       \
+                                } while(0)
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors XorListCtor(ListT* list, ErrorInfo* error, size_t capacity)
+{
+    assert(list);
+    assert(error);
+
+    typedef typename ListT::data_t T;
+    typedef typename ListT::slot_t slot_t;
+
+    if (capacity > GetMaxXorListCapacity<ListT>())
+    {
+        error->code = (int) ListErrors::INDEX_OVERFLOW;
+        error->data = "LIST CAPACITY";
+        return ListErrors::INDEX_OVERFLOW;
+    }
+
+    // fictive element always takes slot 0
+    if (capacity == 0)
+        capacity = 1;
+
+    list->elems = (slot_t*) calloc(capacity, sizeof(slot_t));
+    if (list->elems == nullptr)
+    {
+        error->code = (int) ListErrors::ALLOCATE_MEMORY;
+        error->data = "ELEMENTS ARRAY";
+        return ListErrors::ALLOCATE_MEMORY;
+    }
+
+    if constexpr (ListPoison<T>::ENABLED)
+        list->elems[FICTIVE_ELEM_POS].data = ListPoison<T>::Value();
+
+    list->elems[FICTIVE_ELEM_POS].link = 0;
+
+    list->head     = 0;
+    list->tail     = 0;
+    list->free     = 0;
+
+    list->capacity = capacity;
+    list->size     = 0;
+    list->used     = 1;
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+void XorListDtor(ListT* list)
+{
+    assert(list);
+
+    free(list->elems);
+    list->elems = nullptr;
+
+    list->head     = 0;
+    list->tail     = 0;
+    list->free     = 0;
+
+    list->capacity = 0;
+    list->size     = 0;
+    list->used     = 0;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors XorListVerify(const ListT* list)
+{
+    assert(list);
+
+    typedef typename ListT::data_t T;
+
+    if (list->size > list->capacity)                  return ListErrors::INVALID_SIZE;
+    if (list->used > list->capacity)                  return ListErrors::INVALID_SIZE;
+    if (list->elems[FICTIVE_ELEM_POS].link != (list->head ^ list->tail))
+                                                      return ListErrors::DAMAGED_FICTIVE;
+
+    if constexpr (ListPoison<T>::ENABLED)
+    {
+        if (list->elems[FICTIVE_ELEM_POS].data != ListPoison<T>::Value())
+                                                      return ListErrors::DAMAGED_FICTIVE;
+    }
+
+    if constexpr (ListT::CHECKS == ListChecks::PARANOID)
+    {
+        // every element must be reached from fictive one, walk has to come back to it after the tail
+        XorListCursor cursor = GetXorListBegin(list);
+
+        for (size_t i = 0; i < list->size; i++)
+        {
+            if (IsEmptyXorListElem(list, cursor.cur)) return ListErrors::DAMAGED_LINKS;
+
+            cursor = GetXorListNext(list, cursor);
+
+            if (cursor.cur >= list->used)             return ListErrors::DAMAGED_LINKS;
+        }
+
+        if (cursor.cur  != FICTIVE_ELEM_POS ||
+            cursor.prev != (size_t) list->tail)       return ListErrors::DAMAGED_LINKS;
+    }
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+XorListCursor GetXorListBegin(const ListT* list)
+{
+    assert(list);
+
+    return {FICTIVE_ELEM_POS, (size_t) list->head};
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+XorListCursor GetXorListEnd(const ListT* list)
+{
+    assert(list);
+
+    return {(size_t) list->tail, FICTIVE_ELEM_POS};
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+XorListCursor GetXorListNext(const ListT* list, const XorListCursor cursor)
+{
+    assert(list);
+
+    return {cursor.cur, (size_t) list->elems[cursor.cur].link ^ cursor.prev};
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+XorListCursor GetXorListPrev(const ListT* list, const XorListCursor cursor)
+{
+    assert(list);
+
+    return {(size_t) list->elems[cursor.prev].link ^ cursor.cur, cursor.prev};
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors GetXorListElement(const ListT* list, const XorListCursor cursor, typename ListT::data_t* destination,
+                             ErrorInfo* error)
+{
+    assert(list);
+    assert(destination);
+    assert(error);
+
+    CHECK_XOR_LIST(list);
+
+    CheckXorListCursor(list, cursor, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    if (cursor.cur == FICTIVE_ELEM_POS)
+    {
+        error->code = (int) ListErrors::INVALID_CURSOR;
+        error->data = list;
+        return ListErrors::INVALID_CURSOR;
+    }
+
+    *destination = XorListData(list, cursor);
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors XorListInsertAfter(ListT* list, const XorListCursor cursor, const typename ListT::data_t value,
+                              XorListCursor* inserted, ErrorInfo* error)
+{
+    assert(list);
+    assert(inserted);
+    assert(error);
+
+    CHECK_XOR_LIST(list);
+
+    CheckXorListCursor(list, cursor, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    size_t next_pos = GetXorListNext(list, cursor).cur;
+    size_t pos      = FICTIVE_ELEM_POS;
+
+    TakeXorListSlot(list, &pos, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    list->elems[pos].data = value;
+    LinkXorListElem(list, pos, cursor.cur, next_pos);
+
+    *inserted = {cursor.cur, pos};
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors XorListInsertBefore(ListT* list, const XorListCursor cursor, const typename ListT::data_t value,
+                               XorListCursor* inserted, ErrorInfo* error)
+{
+    assert(list);
+    assert(inserted);
+    assert(error);
+
+    CHECK_XOR_LIST(list);
+
+    CheckXorListCursor(list, cursor, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    size_t pos = FICTIVE_ELEM_POS;
+
+    TakeXorListSlot(list, &pos, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    list->elems[pos].data = value;
+    LinkXorListElem(list, pos, cursor.prev, cursor.cur);
+
+    *inserted = {cursor.prev, pos};
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+ListErrors XorListRemove(ListT* list, const XorListCursor cursor, XorListCursor* next, ErrorInfo* error)
+{
+    assert(list);
+    assert(next);
+    assert(error);
+
+    typedef typename ListT::data_t  T;
+    typedef typename ListT::index_t index_t;
+
+    CHECK_XOR_LIST(list);
+
+    if (list->size == 0)
+    {
+        error->code = (int) ListErrors::EMPTY_LIST;
+        return ListErrors::EMPTY_LIST;
+    }
+
+    CheckXorListCursor(list, cursor, error);
+    RETURN_IF_LISTERROR((ListErrors) error->code);
+
+    if (cursor.cur == FICTIVE_ELEM_POS)
+    {
+        error->code = (int) ListErrors::INVALID_CURSOR;
+        error->data = list;
+        return ListErrors::INVALID_CURSOR;
+    }
+
+    size_t next_pos = GetXorListNext(list, cursor).cur;
+
+    UnlinkXorListElem(list, cursor.cur, cursor.prev, next_pos);
+
+    if constexpr (ListPoison<T>::ENABLED)
+        list->elems[cursor.cur].data = ListPoison<T>::Value();
+
+    list->elems[cursor.cur].link = (index_t) (CHANGE_SIGN * list->free - 1);
+    list->free                   = (index_t) cursor.cur;
+
+    *next = {cursor.prev, next_pos};
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static ListErrors TakeXorListSlot(ListT* list, size_t* pos, ErrorInfo* error)
+{
+    assert(list);
+    assert(pos);
+    assert(error);
+
+    typedef typename ListT::index_t index_t;
+
+    // removed slots are taken first, they are hot in cache
+    if (list->free != FICTIVE_ELEM_POS)
+    {
+        *pos       = (size_t) list->free;
+        list->free = (index_t) (CHANGE_SIGN * list->elems[*pos].link - 1);
+
+        return ListErrors::NONE;
+    }
+
+    if (list->used == list->capacity)
+    {
+        MakeXorListLonger(list, error);
+        RETURN_IF_LISTERROR((ListErrors) error->code);
+    }
+
+    *pos = list->used++;
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static ListErrors MakeXorListLonger(ListT* list, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    typedef typename ListT::slot_t slot_t;
+
+    size_t new_capacity = list->capacity * CAPACITY_MULTIPLIER;
+    size_t max_capacity = GetMaxXorListCapacity<ListT>();
+
+    // the last growth takes only slots, which links can still address
+    if (list->capacity >= max_capacity)
+    {
+        error->code = (int) ListErrors::INDEX_OVERFLOW;
+        error->data = "LIST CAPACITY";
+        return ListErrors::INDEX_OVERFLOW;
+    }
+
+    if (new_capacity > max_capacity)
+        new_capacity = max_capacity;
+
+    slot_t* temp_elems = (slot_t*) realloc(list->elems, new_capacity * sizeof(slot_t));
+    if (temp_elems == nullptr)
+    {
+        error->code = (int) ListErrors::ALLOCATE_MEMORY;
+        error->data = "ELEMENTS ARRAY";
+        return ListErrors::ALLOCATE_MEMORY;
+    }
+
+    list->elems    = temp_elems;
+    list->capacity = new_capacity;
+
+    return ListErrors::NONE;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline void LinkXorListElem(ListT* list, const size_t pos, const size_t prev_pos, const size_t next_pos)
+{
+    assert(list);
+
+    typedef typename ListT::index_t index_t;
+
+    list->elems[pos].link = (index_t) (prev_pos ^ next_pos);
+
+    // in empty list both neighbours are fictive element, its link is changed twice and stays 0
+    XorListLink(list, prev_pos, next_pos, pos);
+    XorListLink(list, next_pos, prev_pos, pos);
+
+    if (prev_pos == FICTIVE_ELEM_POS)
+        list->head = (index_t) pos;
+    if (next_pos == FICTIVE_ELEM_POS)
+        list->tail = (index_t) pos;
+
+    list->size++;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline void UnlinkXorListElem(ListT* list, const size_t pos, const size_t prev_pos, const size_t next_pos)
+{
+    assert(list);
+
+    typedef typename ListT::index_t index_t;
+
+    XorListLink(list, prev_pos, pos, next_pos);
+    XorListLink(list, next_pos, pos, prev_pos);
+
+    if (prev_pos == FICTIVE_ELEM_POS)
+        list->head = (index_t) next_pos;
+    if (next_pos == FICTIVE_ELEM_POS)
+        list->tail = (index_t) prev_pos;
+
+    list->size--;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline void XorListLink(ListT* list, const size_t pos, const size_t removed_pos, const size_t added_pos)
+{
+    assert(list);
+
+    typedef typename ListT::index_t index_t;
+
+    list->elems[pos].link = (index_t) ((size_t) list->elems[pos].link ^ removed_pos ^ added_pos);
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static inline bool IsEmptyXorListElem(const ListT* list, const size_t pos)
+{
+    assert(list);
+
+    return pos == FICTIVE_ELEM_POS || pos >= list->used || list->elems[pos].link < 0;
+}
+
+//-----------------------------------------------------------------------------------------------------
+
+template <class ListT>
+static void CheckXorListCursor(const ListT* list, const XorListCursor cursor, ErrorInfo* error)
+{
+    assert(list);
+    assert(error);
+
+    if constexpr (!IsListChecked<const ListT*>())
+        return;
+
+    // O(1) checks: both slots hold elements and ends of list are paired with fictive element,
+    // cursor of removed element or with wrong previous element is caught in most cases
+    bool valid = (cursor.prev == FICTIVE_ELEM_POS || !IsEmptyXorListElem(list, cursor.prev)) &&
+                 (cursor.cur  == FICTIVE_ELEM_POS || !IsEmptyXorListElem(list, cursor.cur))  &&
+                 (cursor.prev != FICTIVE_ELEM_POS || cursor.cur  == (size_t) list->head)     &&
+                 (cursor.cur  != FICTIVE_ELEM_POS || cursor.prev == (size_t) list->tail)     &&
+                 GetXorListNext(list, cursor).cur < list->used                               &&
+                 GetXorListPrev(list, cursor).prev < list->used;
+
+    if (!valid)
+    {
+        error->code = (int) ListErrors::INVALID_CURSOR;
+        error->data = list;
+    }
+}
+
+#endif